@@ -0,0 +1,315 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Cache of loaded images.  A cache file holds the memory areas, the
+   symbol table, and the text printed while loading, so that a later
+   run on the same input can skip the loader.  Files are named by a
+   hash of the input contents and the options which affect loading.
+
+   The layout is a header followed by arrays of words, symbols, and
+   areas, then the text and the symbol names.  Everything is in host
+   byte order, and the file is used through mmap. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "dis.h"
+#include "memory.h"
+#include "symbols.h"
+
+#define CACHE_MAGIC "DIS10CA3"
+
+struct cache_header
+{
+  char magic[8];
+  uint32_t words;
+  uint32_t symbols;
+  uint32_t areas;
+  uint32_t text_length;
+  uint32_t names_length;
+  int32_t extra;
+  int64_t extra_data;
+  int64_t start;
+  int32_t entry_points;
+  int32_t entry_point[MAX_ENTRY_POINTS];
+};
+
+struct cache_symbol
+{
+  int64_t value;
+  int32_t flags;
+  uint32_t name;
+};
+
+struct cache_area
+{
+  int32_t start, end;
+  uint32_t flags;
+};
+
+static unsigned long long
+fnv (unsigned long long hash, const unsigned char *data, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      hash ^= data[i];
+      hash *= 0x100000001b3ULL;
+    }
+
+  return hash;
+}
+
+unsigned long long
+cache_key (FILE *f, const char *options)
+{
+  unsigned long long hash = 0xcbf29ce484222325ULL;
+  unsigned char buffer[65536];
+  size_t n;
+
+  rewind (f);
+  while ((n = fread (buffer, 1, sizeof buffer, f)) > 0)
+    hash = fnv (hash, buffer, n);
+  rewind_word (f);
+
+  return fnv (hash, (const unsigned char *)options, strlen (options));
+}
+
+static void
+cache_name (char *name, size_t size, const char *dir, unsigned long long key)
+{
+  snprintf (name, size, "%s/%016llx", dir, key);
+}
+
+/* Check that the areas account for exactly the saved words, and that
+   every symbol name is a string inside the names.  A corrupt file
+   would otherwise make the reads below go out of bounds. */
+static int
+valid_cache (const struct cache_header *header,
+	     const struct cache_symbol *symbol,
+	     const struct cache_area *area, const char *names)
+{
+  unsigned long long words = 0;
+  uint32_t i;
+
+  for (i = 0; i < header->areas; i++)
+    {
+      if (area[i].start < 0 || area[i].start > area[i].end)
+	return 0;
+      words += area[i].end - area[i].start;
+    }
+  if (words != header->words)
+    return 0;
+
+  if (header->names_length > 0 && names[header->names_length - 1] != 0)
+    return 0;
+  for (i = 0; i < header->symbols; i++)
+    if (symbol[i].name >= header->names_length)
+      return 0;
+
+  return 1;
+}
+
+int
+read_cache (const char *dir, unsigned long long key,
+	    struct pdp10_memory *memory, struct loaded_file *loaded)
+{
+  const struct cache_header *header;
+  const struct cache_symbol *symbol;
+  const struct cache_area *area;
+  const word_t *words;
+  const char *text, *names;
+  char name[1000];
+  struct stat st;
+  size_t size, offset;
+  word_t *data;
+  void *map;
+  int fd, i;
+
+  cache_name (name, sizeof name, dir, key);
+  fd = open (name, O_RDONLY);
+  if (fd == -1)
+    return -1;
+  if (fstat (fd, &st) == -1 || (size_t)st.st_size < sizeof *header)
+    {
+      close (fd);
+      return -1;
+    }
+  map = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (map == MAP_FAILED)
+    return -1;
+
+  header = map;
+  size = sizeof *header
+    + header->words * sizeof *words
+    + header->symbols * sizeof *symbol
+    + header->areas * sizeof *area
+    + header->text_length + header->names_length;
+  if (memcmp (header->magic, CACHE_MAGIC, 8) != 0 ||
+      size != (size_t)st.st_size ||
+      (uint32_t)header->entry_points > MAX_ENTRY_POINTS)
+    {
+      munmap (map, st.st_size);
+      return -1;
+    }
+
+  offset = sizeof *header;
+  words = (const word_t *)((const char *)map + offset);
+  offset += header->words * sizeof *words;
+  symbol = (const struct cache_symbol *)((const char *)map + offset);
+  offset += header->symbols * sizeof *symbol;
+  area = (const struct cache_area *)((const char *)map + offset);
+  offset += header->areas * sizeof *area;
+  text = (const char *)map + offset;
+  names = text + header->text_length;
+  if (!valid_cache (header, symbol, area, names))
+    {
+      munmap (map, st.st_size);
+      return -1;
+    }
+
+  /* Add the areas from the top down, so that none are merged. */
+  offset = header->words;
+  for (i = header->areas - 1; i >= 0; i--)
+    {
+      size = area[i].end - area[i].start;
+      offset -= size;
+      data = malloc (size * sizeof *data + 1);
+      if (data == NULL)
+	{
+	  fprintf (stderr, "Out of memory.\n");
+	  exit (1);
+	}
+      memcpy (data, words + offset, size * sizeof *data);
+      add_memory (memory, area[i].start, size, data);
+    }
+  for (i = 0; i < (int)header->areas; i++)
+    if (area[i].flags & MEMORY_PURE)
+      purify_memory (memory, area[i].start, area[i].end - area[i].start);
+
+  for (i = 0; i < (int)header->symbols; i++)
+    add_symbol (names + symbol[i].name, symbol[i].value, symbol[i].flags);
+
+  loaded->text = malloc (header->text_length + 1);
+  if (loaded->text == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  memcpy (loaded->text, text, header->text_length);
+  loaded->text_length = header->text_length;
+  loaded->extra = header->extra;
+  loaded->extra_data = header->extra_data;
+  file_context->start_instruction = header->start;
+  file_context->entry_points = header->entry_points;
+  memcpy (file_context->entry_point, header->entry_point,
+	  sizeof header->entry_point);
+
+  munmap (map, st.st_size);
+  return 0;
+}
+
+static void
+write_or_die (FILE *f, const void *data, size_t size, const char *name)
+{
+  if (size > 0 && fwrite (data, size, 1, f) != 1)
+    {
+      fprintf (stderr, "Error writing cache file %s.\n", name);
+      exit (1);
+    }
+}
+
+void
+write_cache (const char *dir, unsigned long long key,
+	     struct pdp10_memory *memory, const struct loaded_file *loaded)
+{
+  struct cache_header header;
+  struct cache_symbol symbol;
+  struct cache_area area;
+  char name[1000], tmp[1020];
+  word_t word;
+  FILE *f;
+  int i, j;
+
+  cache_name (name, sizeof name, dir, key);
+  snprintf (tmp, sizeof tmp, "%s.%d", name, (int)getpid ());
+  f = fopen (tmp, "wb");
+  if (f == NULL)
+    {
+      fprintf (stderr, "Error writing cache file %s.\n", tmp);
+      exit (1);
+    }
+
+  memset (&header, 0, sizeof header);
+  memcpy (header.magic, CACHE_MAGIC, 8);
+  for (i = 0; i < memory->areas; i++)
+    header.words += memory->area[i].end - memory->area[i].start;
+  header.symbols = symbol_table->count;
+  header.areas = memory->areas;
+  header.text_length = loaded->text_length;
+  for (i = 0; i < symbol_table->count; i++)
+    header.names_length += strlen (symbol_table->symbol[i].name) + 1;
+  header.extra = loaded->extra;
+  header.extra_data = loaded->extra_data;
+  header.start = file_context->start_instruction;
+  header.entry_points = file_context->entry_points;
+  memcpy (header.entry_point, file_context->entry_point,
+	  sizeof header.entry_point);
+  write_or_die (f, &header, sizeof header, tmp);
+
+  for (i = 0; i < memory->areas; i++)
+    for (j = memory->area[i].start; j < memory->area[i].end; j++)
+      {
+	word = get_word_at (memory, j);
+	write_or_die (f, &word, sizeof word, tmp);
+      }
+
+  for (i = 0, j = 0; i < symbol_table->count; i++)
+    {
+      symbol.value = symbol_table->symbol[i].value;
+      symbol.flags = symbol_table->symbol[i].flags;
+      symbol.name = j;
+      write_or_die (f, &symbol, sizeof symbol, tmp);
+      j += strlen (symbol_table->symbol[i].name) + 1;
+    }
+
+  for (i = 0; i < memory->areas; i++)
+    {
+      area.start = memory->area[i].start;
+      area.end = memory->area[i].end;
+      area.flags = memory->area[i].flags;
+      write_or_die (f, &area, sizeof area, tmp);
+    }
+
+  write_or_die (f, loaded->text, loaded->text_length, tmp);
+
+  for (i = 0; i < symbol_table->count; i++)
+    write_or_die (f, symbol_table->symbol[i].name,
+		  strlen (symbol_table->symbol[i].name) + 1, tmp);
+
+  if (fclose (f) != 0 || rename (tmp, name) != 0)
+    {
+      fprintf (stderr, "Error writing cache file %s.\n", name);
+      exit (1);
+    }
+}
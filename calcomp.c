@@ -76,7 +76,7 @@ static void calcomp(FILE *f)
 
 int main(void)
 {
-  input_word_format = &aa_word_format;
+  word_context->input_format = &aa_word_format;
   x = y = 0;
   plot = just_move;
   svg_file_begin(stdout);
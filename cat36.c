@@ -97,8 +97,9 @@ default_formats (const char *argv0)
 static void
 convert (char *argv0, char *file)
 {
+  static word_t buffer[1024];
   word_t word, tape;
-  size_t count;
+  size_t count, i, n;
   FILE *f;
 
   if (file == NULL)
@@ -114,19 +115,28 @@ convert (char *argv0, char *file)
         }
     }
 
+  /* Read directly from a memory mapping when possible. */
+  map_word_input (f);
+
   /* Put tape marks between input files. */
   tape = START_FILE;
   count = 0;
 
-  while ((word = get_word (f)) != -1)
+  while ((n = get_words (f, buffer, sizeof buffer / sizeof buffer[0])) > 0)
     {
-      if (block == 0) /* If -B was supplied, ignore input tape structure. */
-        tape |= word & (START_FILE | START_RECORD | START_TAPE);
-      write_word (stdout, (word & mask) | tape);
-      count++;
-      tape = !block || (count % block) ? 0 : START_RECORD;
+      for (i = 0; i < n; i++)
+        {
+          word = buffer[i];
+          /* If -B was supplied, ignore input tape structure. */
+          if (block == 0)
+            tape |= word & (START_FILE | START_RECORD | START_TAPE);
+          write_word (stdout, (word & mask) | tape);
+          count++;
+          tape = !block || (count % block) ? 0 : START_RECORD;
+        }
     }
 
+  unmap_word_input (f);
   if (f != stdin)
     fclose (f);
 }
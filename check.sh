@@ -108,4 +108,7 @@ test_linum -af linum-2.txt
 test_linum -df linum-2.txt
 test_linum -d linum-3.txt
 
+./test/test_unpack
+./test/test_context
+
 exit 0
@@ -18,24 +18,51 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
 #include <getopt.h>
+#include <pthread.h>
 #include "tape-image.h"
 
 typedef unsigned long long word_t;
 
-static uint8_t image[1024 * 1024];
-static uint8_t *ptr = image;
+#define IMAGE (1024 * 1024)
+
+/* State for classifying one tape. */
+struct classify
+{
+  struct tape_image tape;
+  uint8_t *image;		/* Records read so far. */
+  uint8_t *ptr;
+  size_t used;			/* Octets of image written to. */
+  int track_7;
+  int track_9;
+  int simh;
+  int e11;
+  int ansi;
+};
+
+struct result
+{
+  const char *type;
+  char format[100];
+  size_t octets;
+  size_t trailing;
+  double seconds;
+  char *error;
+  int done;
+};
 
 static int eot_flag = 0;
 static int unknown_flag = 0;
 static int tape_format_flag = 0;
+static int json = 0;
 
-static int big_endian = 0;
-static int track_7 = 0;
-static int track_9 = 0;
-static int simh = 0;
-static int e11 = 0;
-static int ansi = 0;
+static char **names;
+static struct result *results;
+static int files, next_file, next_output;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 
 static uint32_t
 read_16bits_l (uint8_t *start)
@@ -50,9 +77,9 @@ read_32bits_l (uint8_t *start)
 }
 
 static word_t
-read_36bits (uint8_t *x)
+read_36bits (struct classify *c, uint8_t *x)
 {
-  if (track_7)
+  if (c->track_7)
     {
       return (((word_t)x[0] & 077) << 30) |
              (((word_t)x[1] & 077) << 24) |
@@ -61,7 +88,7 @@ read_36bits (uint8_t *x)
              (((word_t)x[4] & 077) <<  6) |
              (((word_t)x[5] & 077) <<  0);
     }
-  else if (track_9)
+  else if (c->track_9)
     {
       return (((word_t)x[0] & 0377) << 28) |
              (((word_t)x[1] & 0377) << 20) |
@@ -76,24 +103,30 @@ read_36bits (uint8_t *x)
     }
 }
 
-static void
-check_eot (void)
+/* Read a record into the image, and keep track of how much of it
+   needs to be cleared for the next tape. */
+static uint32_t
+read_image (struct classify *c, uint8_t *buffer, uint32_t n)
+{
+  uint32_t len = read_record (&c->tape, buffer, n);
+  if (len < 0x80000000 && buffer + len > c->image + c->used)
+    c->used = buffer + len - c->image;
+  return len;
+}
+
+/* Find the logical end of tape, and return the number of octets
+   after it. */
+static size_t
+check_eot (struct classify *c)
 {
   int eof = 0;
   uint32_t len;
 
   for (;;)
     {
-      len = read_record (stdin, image, sizeof image);
+      len = read_image (c, c->image, IMAGE);
       if (len == 0 && eof)
-        {
-          int n = 0;
-          while (getchar () != EOF)
-            n++;
-          if (n > 4)
-            printf ("Data after logical end of tape: %d octets.\n", n);
-          exit (0);
-        }
+        return skip_tape_image (&c->tape);
       eof = (len == 0);
     }
 }
@@ -102,7 +135,7 @@ static int
 vms_backup (uint8_t *data, uint32_t len)
 {
   uint32_t x;
-  if (memcmp (data + 0, "\x00\x01", 2) != 0)
+  if (len < 44 || memcmp (data + 0, "\x00\x01", 2) != 0)
     return 0;
   x = data[40] | (data[41] << 8) | (data[42] << 16) | (data[43] << 24);
   if (x != 0 && x != len)
@@ -180,8 +213,10 @@ unix_16bit_tar (uint8_t *data, uint32_t len)
 }
 
 static int
-unix_cpio (uint8_t *data)
+unix_cpio (uint8_t *data, uint32_t len)
 {
+  if (len < 6)
+    return 0;
   if (memcmp (data, "070707", 6) == 0)
     return 1;
   if (memcmp (data, "\xC7\x71", 2) == 0)
@@ -244,87 +279,87 @@ hexdump (uint8_t *data, uint32_t len)
 }
 
 static int
-its_dump_header (uint8_t *data)
+its_dump_header (struct classify *c, uint8_t *data)
 {
   word_t x;
-  x = read_36bits (data) >> 18;
+  x = read_36bits (c, data) >> 18;
   if (x >= 0777772 && x <= 0777776)
     return 1;
-  x = read_36bits (data + 1) >> 18;
+  x = read_36bits (c, data + 1) >> 18;
   if (x >= 0777772 && x <= 0777776)
     return 1;
   return 0;
 }
 
 static int
-its_dump (uint8_t *data, uint32_t len)
+its_dump (struct classify *c, uint8_t *data, uint32_t len)
 {
-  if (!track_7)
+  if (!c->track_7)
     {
-      track_9 = 1;
-      if (its_dump_header (data))
+      c->track_9 = 1;
+      if (its_dump_header (c, data))
         return 1;
-      track_9 = 0;
+      c->track_9 = 0;
     }
 
-  track_7 = 1;
-  if (its_dump_header (data))
+  c->track_7 = 1;
+  if (its_dump_header (c, data))
     return 1;
-  if (len == 6145 && its_dump_header (data + 1))
+  if (len == 6145 && its_dump_header (c, data + 1))
     return 1;
-  if (len == 6146 && its_dump_header (data + 2))
+  if (len == 6146 && its_dump_header (c, data + 2))
     return 1;
-  if (len == 6147 && its_dump_header (data + 3))
+  if (len == 6147 && its_dump_header (c, data + 3))
     return 1;
-  track_7 = 0;
+  c->track_7 = 0;
 
   return 0;
 }
 
 static int
-its_dump_label (uint8_t *data, uint32_t len)
+its_dump_label (struct classify *c, uint8_t *data, uint32_t len)
 {
   if (len != 60)
     return 0;
 
-  track_7 = 1;
+  c->track_7 = 1;
  again:
-  if (read_36bits (data + 1 * 6) != 0)
+  if (read_36bits (c, data + 1 * 6) != 0)
     return 0;
-  if (read_36bits (data + 3 * 6) != 0)
+  if (read_36bits (c, data + 3 * 6) != 0)
     return 0;
-  if (read_36bits (data + 5 * 6) != 0)
+  if (read_36bits (c, data + 5 * 6) != 0)
     return 0;
-  if (read_36bits (data + 7 * 6) != 0)
+  if (read_36bits (c, data + 7 * 6) != 0)
     return 0;
-  if (read_36bits (data + 9 * 6) != 0)
+  if (read_36bits (c, data + 9 * 6) != 0)
     return 0;
 
-  len = read_record (stdin, ptr, sizeof image - (ptr - image));
+  len = read_image (c, c->ptr, IMAGE - (c->ptr - c->image));
   if (len < 0x80000000)
-    ptr += len;
+    c->ptr += len;
   while (len == 0 || (len & 0x80000000) != 0)
     {
-      len = read_record (stdin, ptr, sizeof image - (ptr - image));
+      len = read_image (c, c->ptr, IMAGE - (c->ptr - c->image));
       if (len < 0x80000000)
-        ptr += len;
+        c->ptr += len;
     }
   if (len == 60)
     goto again;
 
-  return its_dump (data, len);
+  return its_dump (c, data, len);
 }
 
 static int
-tops20_install (uint8_t *data, uint32_t len)
+tops20_install (struct classify *c, uint8_t *data, uint32_t len)
 {
   word_t x;
 
   if ((len % 5) != 0)
     return 0;
 
-  track_9 = 1;
-  x = read_36bits (data);
+  c->track_9 = 1;
+  x = read_36bits (c, data);
   if ((x >> 18) == 01776)
     return 1;
 
@@ -332,15 +367,15 @@ tops20_install (uint8_t *data, uint32_t len)
 }
 
 static int
-tops10_failsafe (uint8_t *data, uint32_t len)
+tops10_failsafe (struct classify *c, uint8_t *data, uint32_t len)
 {
   if (len < 25)
     return 0;
 
-  track_9 = 1;
-  if (read_36bits (data + 5) != 0124641515463LL)
+  c->track_9 = 1;
+  if (read_36bits (c, data + 5) != 0124641515463LL)
     return 0;
-  if ((read_36bits (data + 10) >> 18) != 0414645LL)
+  if ((read_36bits (c, data + 10) >> 18) != 0414645LL)
     return 0;
 
   return 1;
@@ -348,8 +383,10 @@ tops10_failsafe (uint8_t *data, uint32_t len)
 
 
 static int
-dos_fat (uint8_t *data)
+dos_fat (uint8_t *data, uint32_t len)
 {
+  if (len < 17)
+    return 0;
   if (read_16bits_l (data + 11) != 512)
     return 0;
   switch (data[13])
@@ -364,39 +401,23 @@ dos_fat (uint8_t *data)
   return 1;
 }
 
-int main (int argc, char **argv)
+/* Read the first records, and return the kind of tape. */
+static const char *
+classify (struct classify *c, uint8_t **record, uint32_t *length)
 {
   uint32_t len;
   uint8_t *data;
-  int opt;
 
-  while ((opt = getopt (argc, argv, "etu")) != -1)
-    switch (opt)
-      {
-      case 'e':
-        eot_flag = 1;
-        break;
-      case 'u':
-        unknown_flag = 1;
-        break;
-      case 't':
-        tape_format_flag = 1;
-        break;
-      default:
-        fprintf (stderr, "Usage: %s [-eut]\n", argv[0]);
-        exit (1);
-      }
-  
   for (;;)
     {
-      data = ptr;
-      len = read_record (stdin, ptr, sizeof image - (ptr - image));
+      data = c->ptr;
+      len = read_image (c, c->ptr, IMAGE - (c->ptr - c->image));
       if ((len == 0) || (len & 0x80000000) != 0)
         continue;
-      ptr += len;
+      c->ptr += len;
       if (ansi_label (data, len))
         {
-          ansi = 1;
+          c->ansi = 1;
           continue;
         }
       if (len < 4)
@@ -404,136 +425,420 @@ int main (int argc, char **argv)
       break;
     }
 
+  *record = data;
+  *length = len;
+
   if ((len % (518 * 5)) == 0)
-    {
-      printf ("TOPS-20 DUMPER");
-    }
+    return "TOPS-20 DUMPER";
 #if 0
   else if (len == 5120)
-    {
-      printf ("ITS DUMP");
-    }
+    return "ITS DUMP";
   else if (len == 6144)
-    {
-      printf ("ITS DUMP");
-    }
+    return "ITS DUMP";
 #endif
-  else if (its_dump (data, len))
-    {
-      printf ("ITS DUMP");
-    }
-  else if (its_dump_label (data, len))
-    {
-      printf ("ITS DUMP (with label)");
-    }
-  else if (strstr ((const char *)data, "TAPE-SYSTEM-VERSION") != NULL)
-    {
-      printf ("Symbolics LMFS dump");
-    }
-  else if (strstr ((const char *)data, "LMFL(") != NULL)
-    {
-      printf ("MIT/LMI dump");
-    }
+  else if (its_dump (c, data, len))
+    return "ITS DUMP";
+  else if (its_dump_label (c, data, len))
+    return "ITS DUMP (with label)";
+  else if (memmem (data, len, "TAPE-SYSTEM-VERSION", 19) != NULL)
+    return "Symbolics LMFS dump";
+  else if (memmem (data, len, "LMFL(", 5) != NULL)
+    return "MIT/LMI dump";
   else if (vms_backup (data, len))
-    {
-      printf ("VMS BACKUP");
-    }
-  else if (memcmp (data + 257, "ustar", 5) == 0)
-    {
-      printf ("Unix ustar");
-    }
+    return "VMS BACKUP";
+  else if (len >= 262 && memcmp (data + 257, "ustar", 5) == 0)
+    return "Unix ustar";
   else if (unix_16bit_tar (data, len))
+    return "Unix 16-bit tar";
+  else if (len >= 28 && memcmp (data + 24, "\x6C\xEA\x00\x00", 4) == 0)
+    return "Unix little endian 32-bit dump";
+  else if (len >= 28 && memcmp (data + 24, "\x00\x00\xEA\x6C", 4) == 0)
+    return "Unix big endian 32-bit dump";
+  else if (len >= 28 && memcmp (data + 24, "\x6B\xEA\x00\x00", 4) == 0)
+    return "Unix little endian 32-bit old dump";
+  else if (len >= 28 && memcmp (data + 24, "\x00\x00\xEA\x6B", 4) == 0)
+    return "Unix big endian 32-bit old dump";
+  else if (len >= 20 && memcmp (data + 18, "\x6B\xEA", 2) == 0)
+    return "Unix 16-bit dump";
+  else if (tops20_install (c, data, len))
+    return "TOPS-20 install";
+  else if (len == 544 * 5)
+    return "TOPS-10 BACKUP";
+  else if (tops10_failsafe (c, data, len))
+    return "TOPS-10 FAILSAFE";
+  else if (dos_fat (data, len))
+    return "FAT file system";
+  else if (unix_cpio (data, len))
+    return "Unix cpio";
+#if 0
+  else if (asciz_text (data, len))
+    return "Raw text";
+#endif
+  else
+    return NULL;
+}
+
+static void
+tape_format (struct classify *c, char *format, size_t size)
+{
+  snprintf (format, size, "%s%s%s-endian%s%s",
+            c->track_7 ? "7-track, " : "",
+            c->track_9 ? "9-track, " : "",
+            c->tape.big_endian ? "big" : "little",
+            c->e11 ? ", E11" : "",
+            c->simh ? ", SIMH" : "");
+}
+
+/* Classify the tape on stdin. */
+static void
+classify_stdin (void)
+{
+  static uint8_t image[IMAGE];
+  struct classify c;
+  const char *type;
+  char format[100];
+  uint32_t len;
+  uint8_t *data;
+  size_t n;
+
+  memset (&c, 0, sizeof c);
+  open_tape_image (&c.tape, stdin);
+  c.image = c.ptr = image;
+
+  type = classify (&c, &data, &len);
+  if (type != NULL)
+    printf ("%s", type);
+  else
     {
-      printf ("Unix 16-bit tar");
+      printf ("Unknown");
+
+      if (unknown_flag)
+        {
+          printf ("\nRecord size: %u %x\n", len, len);
+          hexdump (data, len);
+          len = read_record (&c.tape, image, sizeof image);
+          printf ("Second size: %u %x\n", len, len);
+          if ((len & 0x80000000) == 0)
+            hexdump (data, len);
+          len = read_record (&c.tape, image, sizeof image);
+          printf ("Third size: %u %x\n", len, len);
+          if ((len & 0x80000000) == 0)
+            hexdump (data, len);
+        }
     }
-  else if (memcmp (data + 24, "\x6C\xEA\x00\x00", 4) == 0)
+
+  if (c.ansi)
+    printf (" (ANSI label)");
+
+  if (tape_format_flag)
     {
-      printf ("Unix little endian 32-bit dump");
+      tape_format (&c, format, sizeof format);
+      printf ("  [%s]", format);
     }
-  else if (memcmp (data + 24, "\x00\x00\xEA\x6C", 4) == 0)
+
+  if (eot_flag)
     {
-      printf ("Unix big endian 32-bit dump");
+      n = check_eot (&c);
+      if (n > 4)
+        printf ("Data after logical end of tape: %d octets.\n", (int)n);
+      exit (0);
     }
-  else if (memcmp (data + 24, "\x6B\xEA\x00\x00", 4) == 0)
+
+  putchar ('\n');
+}
+
+static double
+now (void)
+{
+  struct timespec t;
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static void
+classify_file (struct classify *c, const char *name, struct result *r)
+{
+  const char *type;
+  jmp_buf error;
+  uint32_t len;
+  uint8_t *data;
+  char *p;
+
+  r->seconds = now ();
+  if (map_tape_image (&c->tape, name) == -1)
     {
-      printf ("Unix little endian 32-bit old dump");
+      r->type = "";
+      r->error = strdup (strerror (errno));
+      r->seconds = now () - r->seconds;
+      return;
     }
-  else if (memcmp (data + 24, "\x00\x00\xEA\x6B", 4) == 0)
+
+  /* The classifiers may look past the records of this tape. */
+  memset (c->image, 0, c->used);
+  c->used = 0;
+  c->ptr = c->image;
+  c->track_7 = c->track_9 = c->simh = c->e11 = c->ansi = 0;
+  c->tape.error = &error;
+  r->type = "";
+  if (setjmp (error) == 0)
     {
-      printf ("Unix big endian 32-bit old dump");
+      type = classify (c, &data, &len);
+      r->type = type ? type : "Unknown";
+      r->octets = c->tape.position;
+      if (eot_flag)
+        r->trailing = check_eot (c);
     }
-  else if (memcmp (data + 18, "\x6B\xEA", 2) == 0)
+  else
     {
-      printf ("Unix 16-bit dump");
+      /* A record may be partly read. */
+      c->used = IMAGE;
+      r->octets = c->tape.position;
+      r->error = strdup (c->tape.message);
+      while ((p = strchr (r->error, '\n')) != NULL)
+        *p = p[1] ? ' ' : 0;
     }
-  else if (tops20_install (data, len))
+
+  tape_format (c, r->format, sizeof r->format);
+  close_tape_image (&c->tape);
+  r->seconds = now () - r->seconds;
+}
+
+static void
+csv_string (const char *s)
+{
+  putchar ('"');
+  for (; *s; s++)
     {
-      printf ("TOPS-20 install");
+      if (*s == '"')
+        putchar ('"');
+      putchar (*s);
     }
-  else if (len == 544 * 5)
+  putchar ('"');
+}
+
+static void
+json_string (const char *s)
+{
+  putchar ('"');
+  for (; *s; s++)
     {
-      printf ("TOPS-10 BACKUP");
+      if (*s == '"' || *s == '\\')
+        printf ("\\%c", *s);
+      else if ((unsigned char)*s < 32)
+        printf ("\\u%04x", *s);
+      else
+        putchar (*s);
     }
-  else if (tops10_failsafe (data, len))
-    {
-      printf ("TOPS-10 FAILSAFE");
+  putchar ('"');
+}
+
+static void
+print_result (int i)
+{
+  struct result *r = &results[i];
+
+  if (json)
+    {
+      fputs ("{\"file\":", stdout);
+      json_string (names[i]);
+      fputs (",\"type\":", stdout);
+      json_string (r->type);
+      fputs (",\"format\":", stdout);
+      json_string (r->format);
+      printf (",\"octets\":%zu,\"seconds\":%.6f", r->octets, r->seconds);
+      if (eot_flag)
+        printf (",\"trailing\":%zu", r->trailing);
+      if (r->error != NULL)
+        {
+          fputs (",\"error\":", stdout);
+          json_string (r->error);
+        }
+      fputs ("}\n", stdout);
     }
-  else if (dos_fat (data))
+  else
     {
-      printf ("FAT file system");
+      csv_string (names[i]);
+      putchar (',');
+      csv_string (r->type);
+      putchar (',');
+      csv_string (r->format);
+      printf (",%zu,%.6f,", r->octets, r->seconds);
+      if (eot_flag)
+        printf ("%zu,", r->trailing);
+      csv_string (r->error ? r->error : "");
+      putchar ('\n');
     }
-  else if (unix_cpio (data))
+}
+
+/* Workers take the next file, and print the results in order. */
+static void *
+worker (void *arg)
+{
+  struct classify c;
+  int i;
+
+  (void)arg;
+  memset (&c, 0, sizeof c);
+  c.image = calloc (1, IMAGE);
+  if (c.image == NULL)
     {
-      printf ("Unix cpio");
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
     }
-#if 0
-  else if (asciz_text (data, len))
+
+  for (;;)
     {
-      printf ("Raw text");
+      pthread_mutex_lock (&lock);
+      i = next_file++;
+      pthread_mutex_unlock (&lock);
+      if (i >= files)
+        break;
+
+      classify_file (&c, names[i], &results[i]);
+
+      pthread_mutex_lock (&lock);
+      results[i].done = 1;
+      while (next_output < files && results[next_output].done)
+        print_result (next_output++);
+      pthread_mutex_unlock (&lock);
     }
-#endif
-  else
+
+  free (c.image);
+  return NULL;
+}
+
+static void
+classify_files (int threads)
+{
+  pthread_t *thread;
+  double t;
+  int i;
+
+  results = calloc (files, sizeof *results);
+  thread = malloc (threads * sizeof *thread);
+  if (results == NULL || thread == NULL)
     {
-      printf ("Unknown");
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
 
-      if (unknown_flag)
+  if (!json)
+    printf ("file,type,format,octets,seconds,%serror\n",
+            eot_flag ? "trailing," : "");
+
+  t = now ();
+  if (threads > files)
+    threads = files;
+  for (i = 0; i < threads; i++)
+    if (pthread_create (&thread[i], NULL, worker, NULL) != 0)
+      {
+        fprintf (stderr, "Error creating thread.\n");
+        exit (1);
+      }
+  for (i = 0; i < threads; i++)
+    pthread_join (thread[i], NULL);
+  t = now () - t;
+
+  fprintf (stderr, "%d files in %.3f seconds, %.0f files/s.\n",
+           files, t, t > 0 ? files / t : 0);
+}
+
+static void
+add_name (char *name)
+{
+  static int size = 0;
+
+  if (files == size)
+    {
+      size = size ? 2 * size : 64;
+      names = realloc (names, size * sizeof *names);
+      if (names == NULL)
         {
-          printf ("\nRecord size: %u %x\n", len, len);
-          hexdump (data, len);
-          len = read_record (stdin, image, sizeof image);
-          printf ("Second size: %u %x\n", len, len);
-          if ((len & 0x80000000) == 0)
-            hexdump (data, len);
-          len = read_record (stdin, image, sizeof image);
-          printf ("Third size: %u %x\n", len, len);
-          if ((len & 0x80000000) == 0)
-            hexdump (data, len);
+          fprintf (stderr, "Out of memory.\n");
+          exit (1);
         }
     }
+  names[files++] = name;
+}
 
-  if (ansi)
-    printf (" (ANSI label)");
+static void
+read_list (const char *list)
+{
+  char *line = NULL;
+  size_t length = 0;
+  ssize_t m;
+  FILE *f;
 
-  if (tape_format_flag)
+  f = strcmp (list, "-") == 0 ? stdin : fopen (list, "r");
+  if (f == NULL)
     {
-      printf ("  [");
-      if (track_7)
-        printf ("7-track, ");
-      if (track_9)
-        printf ("9-track, ");
-      printf ("%s-endian",
-              big_endian ? "big" : "little");
-      if (e11)
-        printf (", E11");
-      if (simh)
-        printf (", SIMH");
-      printf ("]");
+      fprintf (stderr, "Error opening %s: %s\n", list, strerror (errno));
+      exit (1);
     }
 
-  if (eot_flag)
-    check_eot ();
+  while ((m = getline (&line, &length, f)) != -1)
+    {
+      if (m > 0 && line[m - 1] == '\n')
+        line[--m] = 0;
+      if (m == 0)
+        continue;
+      add_name (strdup (line));
+    }
 
-  putchar ('\n');
+  free (line);
+  if (f != stdin)
+    fclose (f);
+}
+
+static void
+usage (const char *x)
+{
+  fprintf (stderr, "Usage: %s [-eut] < tape\n", x);
+  fprintf (stderr, "       %s [-eJ] [-j threads] [-l list] [tapes...]\n", x);
+  exit (1);
+}
+
+int main (int argc, char **argv)
+{
+  int threads = sysconf (_SC_NPROCESSORS_ONLN);
+  int opt;
+
+  while ((opt = getopt (argc, argv, "etuJj:l:")) != -1)
+    switch (opt)
+      {
+      case 'e':
+        eot_flag = 1;
+        break;
+      case 'u':
+        unknown_flag = 1;
+        break;
+      case 't':
+        tape_format_flag = 1;
+        break;
+      case 'J':
+        json = 1;
+        break;
+      case 'j':
+        threads = atoi (optarg);
+        if (threads < 1)
+          usage (argv[0]);
+        break;
+      case 'l':
+        read_list (optarg);
+        break;
+      default:
+        usage (argv[0]);
+      }
+
+  for (; optind < argc; optind++)
+    add_name (argv[optind]);
+
+  if (files == 0)
+    classify_stdin ();
+  else if (unknown_flag)
+    usage (argv[0]);
+  else
+    classify_files (threads < 1 ? 1 : threads);
 
   return 0;
 }
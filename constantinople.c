@@ -23,9 +23,11 @@ order, put exclamation marks after. */
 
 #include "dis.h"
 #include "memory.h"
+#include "references.h"
 #include "opcode/pdp10.h"
 
 static int ascending = 0;
+static struct pdp10_references references;
 
 static int
 reference (const char *format, int first, int address)
@@ -42,21 +44,21 @@ reference (const char *format, int first, int address)
 }
 
 static void
-check (struct pdp10_memory *memory, int address)
+check (int address)
 {
+  const int *from;
   int first = 1;
-  word_t data;
-  int i;
+  int i, n;
 
-  for (i = 0; i <= 0777777; i++)
+  from = get_references (&references, address, &n);
+  for (i = 0; i < n; i++)
     {
-      data = get_word_at (memory, i);
-      if (data == -1)
+      if (REFERENCE_ADDRESS (from[i]) > 0777777)
         continue;
-      if ((data & 0777777) == address)
-        first = reference (" %06o", first, i);
-      if (((data >> 18) & 0777777) == address)
-        first = reference (" (%06o)", first, i);
+      if (from[i] & REFERENCE_LEFT)
+        first = reference (" (%06o)", first, REFERENCE_ADDRESS (from[i]));
+      else
+        first = reference (" %06o", first, from[i]);
     }
 }
 
@@ -65,15 +67,18 @@ analyse_consta (struct pdp10_memory *memory, int start, int end)
 {
   word_t data;
   int i;
+
+  build_references (&references, memory);
   for (i = start; i <= end; i++)
     {
       data = get_word_at (memory, i);
       if (data == -1)
         continue;
       printf ("%06o/%012llo: ", i, data);
-      check (memory, i);
+      check (i);
       printf ("\n");
     }
+  free_references (&references);
 }
 
 static void
@@ -91,7 +96,7 @@ main (int argc, char **argv)
   struct pdp10_memory memory;
   FILE *file = stdin;
   int start, end;
-  input_file_format = &sblk_file_format;
+  file_context->input_format = &sblk_file_format;
 
   while ((opt = getopt (argc, argv, "F:W:")) != -1)
     {
@@ -124,8 +129,8 @@ main (int argc, char **argv)
   if (optind != argc)
     usage (argv);
 
-  output_file = fopen ("/dev/null", "w");
+  file_context->output = fopen ("/dev/null", "w");
   init_memory (&memory);
-  input_file_format->read (file, &memory, cpu_model);
+  file_context->input_format->read (file, &memory, cpu_model);
   analyse_consta (&memory, start, end);
 }
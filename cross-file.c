@@ -21,9 +21,9 @@
 header of three words describing its type, length, and address.  After
 the data bytes comes a checksum byte. */
 
-static unsigned char buf[4];
-static int n = 0;
-static int checksum;
+static __thread unsigned char buf[4];
+static __thread int n = 0;
+static __thread int checksum;
 
 static void refill (FILE *f)
 {
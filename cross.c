@@ -217,7 +217,7 @@ static void usage (const char *argv0)
 
 int main (int argc, char **argv)
 {
-  input_word_format = &its_word_format;
+  word_context->input_format = &its_word_format;
   void (*block) (FILE *);
   int opt;
 
@@ -22,10 +22,8 @@
 #define BITMASK(width) ((1LL << (width)) - 1)
 #define FIELD(pos, width, value) (((value) >> (pos)) & BITMASK (width))
 
-static word_t random_seed;
-
 static word_t
-get_random (void)
+get_random (word_t *seed)
 {
   word_t exp, frac, half;
 
@@ -37,9 +35,9 @@ get_random (void)
      positive. */
 
   /* Unpack the input and make it positive. */
-  exp = FIELD (27, 8, random_seed) - 0200;
-  frac = FIELD (0, 27, random_seed);
-  if ((random_seed >> 35) & 1) {
+  exp = FIELD (27, 8, *seed) - 0200;
+  frac = FIELD (0, 27, *seed);
+  if ((*seed >> 35) & 1) {
     /* Negative input. */
     exp ^= BITMASK (8);
     frac |= ~BITMASK (27);
@@ -62,10 +60,10 @@ get_random (void)
     exp = 0;
 
   /* Pack it back together. */
-  random_seed = ((exp & BITMASK (8)) << 27) | (frac & BITMASK (27));
+  *seed = ((exp & BITMASK (8)) << 27) | (frac & BITMASK (27));
 
   /* TSC B,B - XOR the two halves together to give the result. */
-  half = (random_seed >> 18) ^ (random_seed & BITMASK (18));
+  half = (*seed >> 18) ^ (*seed & BITMASK (18));
   return (half << 18) | half;
 }
 
@@ -79,43 +77,20 @@ typedef enum
    NUM_STEPS,
   } scramble_t;
 
-static int
-scramble_step_compare (const void *a, const void *b)
+/* Decide what order to do the possible scrambling operations in.
+   When encrypting, the largest order goes first. */
+static void
+scramble_steps (int decrypt, word_t password, word_t *steps)
 {
-  /* When encrypting, the largest order goes first. */
-  word_t a_order = *((word_t *) a);
-  word_t b_order = *((word_t *) b);
-  if (a_order < b_order)
-    return 1;
-  else if (a_order == b_order)
-    return 0;
-  else
-    return -1;
-}
-
-void
-scramble (int decrypt, int verbose, word_t password, const word_t *input, word_t *output, int count)
-{
-  int i, j;
-  int shift_size = 0;
-  word_t steps[NUM_STEPS];
   word_t word;
+  int i, j;
 
-  /* Decide what order to do the possible scrambling operations in. */
   for (i = 0; i < NUM_STEPS; i++)
     {
-      steps[i] = (FIELD (27 - (9 * i), 8, password) << 18) | i;
-    }
-  qsort (steps, NUM_STEPS, sizeof (*steps), scramble_step_compare);
-  if (decrypt)
-    {
-      /* Reverse the order. */
-      for (i = 0; i < NUM_STEPS / 2; i++)
-        {
-          word = steps[i];
-          steps[i] = steps[NUM_STEPS - i - 1];
-          steps[NUM_STEPS - i - 1] = word;
-        }
+      word = (FIELD (27 - (9 * i), 8, password) << 18) | i;
+      for (j = i; j > 0 && (steps[j - 1] < word) != decrypt; j--)
+        steps[j] = steps[j - 1];
+      steps[j] = word;
     }
 
   /* Enable/disable optional operations. */
@@ -138,18 +113,17 @@ scramble (int decrypt, int verbose, word_t password, const word_t *input, word_t
         /* SCRAMBLE_ROTATE always happens. */
         break;
       }
+}
 
-  /* Compute initial random seed. */
-  if (FIELD (032, 1, password))
-    random_seed = (password >> 18) & BITMASK (18);
-  else
-    random_seed = password & BITMASK (18);
-  if (FIELD (010, 1, password))
-    random_seed |= 1LL << 18;
-  else
-    random_seed <<= 1;
-  if (FIELD (021, 1, password))
-    random_seed = (-random_seed) & WORDMASK;
+/* Every step is either an exclusive or, or a rotation.  Precompute
+   them for a password, and the initial random seed. */
+void
+scramble_key (struct scramble_key *key, int decrypt, word_t password)
+{
+  word_t steps[NUM_STEPS];
+  int i, shift_size;
+
+  scramble_steps (decrypt, password, steps);
 
   /* Compute SCRAMBLE_ROTATE shift size. */
   shift_size = (password * password) & 077;
@@ -161,11 +135,100 @@ scramble (int decrypt, int verbose, word_t password, const word_t *input, word_t
   if (decrypt)
     shift_size = 36 - shift_size;
 
+  for (i = 0; i < NUM_STEPS; i++)
+    {
+      key->mask[i] = 0;
+      key->rotate[i] = 0;
+      switch (steps[i] & BITMASK (18))
+        {
+        case SCRAMBLE_COMPLEMENT:
+          key->mask[i] = WORDMASK;
+          break;
+        case SCRAMBLE_SWAP:
+          key->rotate[i] = 18;
+          break;
+        case SCRAMBLE_XOR:
+          key->mask[i] = password;
+          break;
+        case SCRAMBLE_ROTATE:
+          key->rotate[i] = shift_size;
+          break;
+        default:
+          break;
+        }
+    }
+
+  /* Compute initial random seed. */
+  if (FIELD (032, 1, password))
+    key->seed = (password >> 18) & BITMASK (18);
+  else
+    key->seed = password & BITMASK (18);
+  if (FIELD (010, 1, password))
+    key->seed |= 1LL << 18;
+  else
+    key->seed <<= 1;
+  if (FIELD (021, 1, password))
+    key->seed = (-key->seed) & WORDMASK;
+}
+
+static inline word_t
+rotate (word_t word, int n)
+{
+  return ((word << n) | (word >> (36 - n))) & WORDMASK;
+}
+
+/* Scramble or unscramble the next word with a key. */
+word_t
+scramble_word (struct scramble_key *key, int decrypt, word_t word)
+{
+  int j;
+
+  if (!decrypt)
+    word ^= get_random (&key->seed);
+
+  for (j = 0; j < NUM_STEPS; j++)
+    word = rotate (word ^ key->mask[j], key->rotate[j]);
+
+  if (decrypt)
+    word ^= get_random (&key->seed);
+
+  return word;
+}
+
+/* Unscramble the same word with many keys.  Each step is done for all
+   keys before the next, so the compiler can vectorize the loops. */
+void
+unscramble_lanes (struct scramble_key *key, int n, word_t input,
+                  word_t *output)
+{
+  int i, j;
+
+  for (i = 0; i < n; i++)
+    output[i] = input;
+
+  for (j = 0; j < NUM_STEPS; j++)
+    for (i = 0; i < n; i++)
+      output[i] = rotate (output[i] ^ key[i].mask[j], key[i].rotate[j]);
+
+  for (i = 0; i < n; i++)
+    output[i] ^= get_random (&key[i].seed);
+}
+
+void
+scramble (int decrypt, int verbose, word_t password, const word_t *input, word_t *output, int count)
+{
+  struct scramble_key key;
+  word_t steps[NUM_STEPS];
+  int i;
+
+  scramble_key (&key, decrypt, password);
+
   if (verbose)
     {
       /* Show our equivalents of SCRMBL's variables, for comparison. */
+      scramble_steps (decrypt, password, steps);
       fprintf (stderr, "SCR/ %012llo\n", password);
-      fprintf (stderr, "RAN/ %012llo\n", random_seed);
+      fprintf (stderr, "RAN/ %012llo\n", key.seed);
       for (i = 0; i < NUM_STEPS; i++)
         {
           fprintf (stderr, "X%d/  %012llo\n", i + 1, steps[i]);
@@ -173,36 +236,5 @@ scramble (int decrypt, int verbose, word_t password, const word_t *input, word_t
     }
 
   for (i = 0; i < count; i++)
-    {
-      word = input[i];
-
-      if (!decrypt)
-        word ^= get_random ();
-
-      for (j = 0; j < NUM_STEPS; j++)
-        switch (steps[j] & BITMASK (18))
-          {
-          case SCRAMBLE_COMPLEMENT:
-            word = (~word) & WORDMASK;
-            break;
-          case SCRAMBLE_SWAP:
-            word = ((word >> 18) & BITMASK(18)) | ((word & BITMASK (18)) << 18);
-            break;
-          case SCRAMBLE_XOR:
-            word ^= password;
-            break;
-          case SCRAMBLE_ROTATE:
-            word = (FIELD (0, 36 - shift_size, word) << shift_size)
-              | FIELD (36 - shift_size, shift_size, word);
-            break;
-          default:
-            break;
-          }
-
-      if (decrypt)
-        word ^= get_random ();
-
-      output[i] = word;
-    }
+    output[i] = scramble_word (&key, decrypt, input[i]);
 }
-
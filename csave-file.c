@@ -27,7 +27,7 @@ read_csave (FILE *f, struct pdp10_memory *memory, int cpu_model)
   word_t word;
   int i;
 
-  fprintf (output_file, "Nonsharable/compressed SAVE format\n");
+  fprintf (file_context->output, "Nonsharable/compressed SAVE format\n");
 
   while ((word = get_word (f)) & SIGNBIT)
     {
@@ -52,7 +52,7 @@ read_csave (FILE *f, struct pdp10_memory *memory, int cpu_model)
   length = (word >> 18) & 0777777;
   address = word & 0777777;
 
-  fprintf (output_file, "\n");
+  fprintf (file_context->output, "\n");
   dec_info (memory, length, address, cpu_model);
 }
 
@@ -99,7 +99,7 @@ write_csave (FILE *f, struct pdp10_memory *memory)
 {
   write_dec_symbols (memory);
   write_core (f, memory);
-  write_word (f, JRST + (start_instruction & 0777777));
+  write_word (f, JRST + (file_context->start_instruction & 0777777));
 }
 
 struct file_format csave_file_format = {
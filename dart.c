@@ -777,9 +777,9 @@ static void
 write_tape (FILE *f)
 {
   int i;
-  struct word_format *tmp = input_word_format;
-  input_word_format = output_word_format;
-  output_word_format = tmp;
+  struct word_format *tmp = word_context->input_format;
+  word_context->input_format = word_context->output_format;
+  word_context->output_format = tmp;
 
   if (f == NULL)
     f = stdout;
@@ -809,6 +809,15 @@ newline (void)
     fputc ('\n', list);
 }
 
+static void
+report (void)
+{
+  if (word_context->tape.records == 0)
+    return;
+  fputc ('\n', info);
+  report_tape_rate (info);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -820,8 +829,8 @@ main (int argc, char **argv)
   int opt;
 
   tape_bpi = 6250;
-  input_word_format = &tape_word_format;
-  output_word_format = &aa_word_format;
+  word_context->input_format = &tape_word_format;
+  word_context->output_format = &aa_word_format;
 
   /* If you ask for a file listing with -t or -xv, it's considered the
      output data and written to stdout.  Overriden by -c, see below. */
@@ -881,17 +890,17 @@ main (int argc, char **argv)
 	  iover = opt - '0';
 	  break;
 	case '7':
-	  input_word_format = &tape7_word_format;
+	  word_context->input_format = &tape7_word_format;
 	  tape_bpw = 6;
 	  tape_bpi = 800;
 	  break;
 	case '8':
-	  input_word_format = &data8_word_format;
+	  word_context->input_format = &data8_word_format;
 	  tape_bpw = 5;
 	  tape_bpi = 6250;
 	  break;
 	case '9':
-	  input_word_format = &tape_word_format;
+	  word_context->input_format = &tape_word_format;
 	  tape_bpw = 5;
 	  tape_bpi = 6250;
 	  break;
@@ -929,6 +938,8 @@ main (int argc, char **argv)
 	       optarg, strerror (errno));
       exit (1);
     }
+  if (tape_name && *mode == 'r')
+    map_word_input (f);
 
   if (directory && chdir (directory) == -1)
     {
@@ -943,6 +954,7 @@ main (int argc, char **argv)
 
   file_argc = argc - optind;
   file_argv = argv + optind;
+  atexit (report);
   atexit (newline);
   process_tape (f);
 
@@ -49,7 +49,7 @@ static void
 load_file (FILE *f, struct pdp10_memory *memory)
 {
   init_memory (memory);
-  input_file_format->read (f, memory, 0);
+  file_context->input_format->read (f, memory, 0);
   rewind_word (f);
 }
 
@@ -101,12 +101,12 @@ main (int argc, char **argv)
   FILE *f;
   int opt;
 
-  input_file_format = &csave_file_format;
-  input_word_format = &aa_word_format;
-  output_word_format = &dta_word_format;
+  file_context->input_format = &csave_file_format;
+  word_context->input_format = &aa_word_format;
+  word_context->output_format = &dta_word_format;
   verbose = 0;
 
-  output_file = fopen ("/dev/null", "w");
+  file_context->output = fopen ("/dev/null", "w");
 
   while ((opt = getopt (argc, argv, "vF:W:")) != -1)
     {
@@ -16,12 +16,15 @@
 #define _GNU_SOURCE /* for strcasestr */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "opcode/pdp10.h"
 #include "dis.h"
 #include "memory.h"
 #include "symbols.h"
+#include "references.h"
 #include "timing.h"
 
 #define OPCODE(word)	(int)(((word) >> 27) &    0777)
@@ -287,38 +290,210 @@ static struct its_oper waits_callis[] =
   { "rdline",	0400123, 0 },
 };
 
+/* Disassembly is formatted into a text buffer.  The default buffer
+   is written to output_file a line at a time, or in large chunks from
+   dis.  Threads each have their own. */
+#define FLUSH_SIZE 65536
+
+struct text
+{
+  char *data;
+  size_t length, size;
+};
+
+static __thread struct text text;
+
+static void
+flush_text (struct text *t)
+{
+  if (t->length > 0)
+    fwrite (t->data, 1, t->length, file_context->output);
+  t->length = 0;
+}
+
+static char *
+reserve (struct text *t, size_t n)
+{
+  if (t->length + n > t->size)
+    {
+      t->size = 2 * (t->length + n);
+      t->data = realloc (t->data, t->size);
+      if (t->data == NULL)
+	{
+	  fprintf (stderr, "Out of memory.\n");
+	  exit (1);
+	}
+    }
+
+  return t->data + t->length;
+}
+
+static int
+out_char (struct text *t, int c)
+{
+  *reserve (t, 1) = c;
+  t->length++;
+  return 1;
+}
+
+static int
+out_string (struct text *t, const char *s)
+{
+  size_t n = strlen (s);
+  memcpy (reserve (t, n), s, n);
+  t->length += n;
+  return n;
+}
+
+/* Print a string left justified in a field. */
+static int
+out_field (struct text *t, const char *s, int width)
+{
+  int n = out_string (t, s);
+  for (; n < width; n++)
+    out_char (t, ' ');
+  return n;
+}
+
+/* Print a number in octal, padded with zeroes to at least some
+   number of digits. */
 static int
-spaces (int n)
+out_octal (struct text *t, unsigned long long x, int digits)
+{
+  char buffer[24], *p = buffer + sizeof buffer;
+  int n;
+
+  do
+    {
+      *--p = '0' + (x & 7);
+      x >>= 3;
+    }
+  while (x != 0);
+
+  while (buffer + sizeof buffer - p < digits)
+    *--p = '0';
+
+  n = buffer + sizeof buffer - p;
+  memcpy (reserve (t, n), p, n);
+  t->length += n;
+  return n;
+}
+
+static int
+spaces (struct text *t, int n)
 {
   int i;
 
   for (i = 0; i < n; i++)
-    fputc (' ', output_file);
+    out_char (t, ' ');
 
   return i < 0 ? 0 : i;
 }
 
-static const struct pdp10_instruction *
-lookup (word_t word, int cpu_model)
+/* Instruction decoding only depends on the opcode and A fields, so
+   lookup is done in a table indexed by those 13 bits.  There is one
+   table per CPU model, built when first needed and then shared by all
+   threads. */
+#define DECODE_KEY(word)	(int)(((word) >> 23) & 017777)
+#define DECODE_SIZE		(1 << 13)
+
+struct decode_table
 {
-  int i, opcode;
+  struct decode_table *next;
+  int model;
+  const struct pdp10_instruction *op[DECODE_SIZE];
+};
 
-  for (i = 0; i < pdp10_num_instructions; i++)
+static struct decode_table *decode_tables = NULL;
+static pthread_mutex_t decode_lock = PTHREAD_MUTEX_INITIALIZER;
+static __thread struct decode_table *decode_table = NULL;
+
+static void
+build_decode_table (struct decode_table *table, int cpu_model)
+{
+  const struct pdp10_instruction *op;
+  int i, mask, value, free, f;
+
+  for (i = 0; i < DECODE_SIZE; i++)
+    table->op[i] = NULL;
+
+  /* Go through the opcode table backwards, so that the first match
+     in table order is the one that ends up in the decode table. */
+  for (i = pdp10_num_instructions - 1; i >= 0; i--)
     {
-      if (pdp10_instruction[i].type & PDP10_A_OPCODE)
-	opcode = OPCODE_A (word);
-      else if (pdp10_instruction[i].type & PDP10_A_XCTRI)
-	opcode = OPCODE_A (word) & 077720; /* Just keep the XCTRI bit. */
-      else if (pdp10_instruction[i].type & PDP10_IO)
-	opcode = OPCODE_A (word) & 070034;
+      op = &pdp10_instruction[i];
+      if (!(op->model & cpu_model))
+	continue;
+
+      if (op->type & PDP10_A_OPCODE)
+	mask = 017777;
+      else if (op->type & PDP10_A_XCTRI)
+	mask = 077720 >> 2; /* Just keep the XCTRI bit. */
+      else if (op->type & PDP10_IO)
+	mask = 070034 >> 2;
       else
-	opcode = OPCODE (word);
-      if (opcode == pdp10_instruction[i].opcode &&
-	  (pdp10_instruction[i].model & cpu_model))
-	return &pdp10_instruction[i];
+	mask = 017760;
+
+      if (op->type & (PDP10_A_OPCODE | PDP10_A_XCTRI | PDP10_IO))
+	{
+	  if (op->opcode & 3)
+	    continue;
+	  value = op->opcode >> 2;
+	}
+      else
+	value = op->opcode << 4;
+
+      if (value & ~mask)
+	continue;
+
+      /* Fill in every key which matches in the masked bits. */
+      free = ~mask & 017777;
+      f = 0;
+      do
+	{
+	  table->op[value | f] = op;
+	  f = (f - free) & free;
+	}
+      while (f != 0);
     }
 
-  return NULL;
+  table->model = cpu_model;
+}
+
+static struct decode_table *
+find_decode_table (int cpu_model)
+{
+  struct decode_table *table;
+
+  pthread_mutex_lock (&decode_lock);
+  for (table = decode_tables; table != NULL; table = table->next)
+    if (table->model == cpu_model)
+      break;
+
+  if (table == NULL)
+    {
+      table = malloc (sizeof *table);
+      if (table == NULL)
+	{
+	  fprintf (stderr, "Out of memory.\n");
+	  exit (1);
+	}
+      build_decode_table (table, cpu_model);
+      table->next = decode_tables;
+      decode_tables = table;
+    }
+  pthread_mutex_unlock (&decode_lock);
+
+  return table;
+}
+
+static const struct pdp10_instruction *
+lookup (word_t word, int cpu_model)
+{
+  if (decode_table == NULL || decode_table->model != cpu_model)
+    decode_table = find_decode_table (cpu_model);
+
+  return decode_table->op[DECODE_KEY (word)];
 }
 
 static const struct pdp10_device *
@@ -352,47 +527,658 @@ lookup_oper (word_t word, struct its_oper *table, int size)
   return NULL;
 }
 
-int
-calc_e (struct pdp10_memory *memory, word_t word)
+/* Each thread keeps the addresses on the chain being followed. */
+static __thread int *chain = NULL;
+static __thread int chain_size = 0;
+
+/* Follow a chain of indirect words starting at an address, and return
+   the effective address at the end of it.  Return -1 if the chain
+   uses an index register, leaves memory, or loops.  Loops are found
+   with Brent's algorithm.  The result is remembered for every word on
+   the chain, so following the same chain again is quick. */
+static int
+resolve_indirect (struct pdp10_memory *memory, int address)
 {
-  int e;
+  int power = 1, length = 1, tortoise = -1;
+  int e, i, n = 0;
+  word_t word;
 
   for (;;)
     {
-      if (X (word) != 0)
-	return -1;
+      if (get_indirect_memo (memory, address, &e))
+	break;
 
-      e = Y (word);
+      word = get_word_at (memory, address);
+      if (word == -1 || X (word) != 0)
+	{
+	  e = -1;
+	  break;
+	}
       if (!I (word))
-	break;
+	{
+	  e = Y (word);
+	  break;
+	}
+
+      if (n == chain_size)
+	{
+	  chain_size = chain_size ? 2 * chain_size : 64;
+	  chain = realloc (chain, chain_size * sizeof *chain);
+	  if (chain == NULL)
+	    {
+	      fprintf (stderr, "Out of memory.\n");
+	      exit (1);
+	    }
+	}
+      chain[n++] = address;
 
-      word = get_word_at (memory, e);
+      if (power == length)
+	{
+	  tortoise = address;
+	  power *= 2;
+	  length = 0;
+	}
+      address = Y (word);
+      length++;
+      if (address == tortoise)
+	{
+	  e = -1;
+	  break;
+	}
     }
-  
+
+  for (i = 0; i < n; i++)
+    set_indirect_memo (memory, chain[i], e);
   return e;
 }
 
+int
+calc_e (struct pdp10_memory *memory, word_t word)
+{
+  if (X (word) != 0)
+    return -1;
+  if (!I (word))
+    return Y (word);
+  return resolve_indirect (memory, Y (word));
+}
+
+/* Where an instruction may go next, as FLOW_ bits, from the type of
+   the instruction in the opcode table.  The target is the effective
+   address if it doesn't depend on an index or indirection, or else -1.
+   Return 0 if the instruction doesn't go on anywhere known, as POPJ,
+   and -1 if the word isn't an instruction.  A user UUO which isn't in
+   the table is taken to return to the next word, or skip it. */
+int
+instruction_flow (word_t word, int cpu_model, int *target)
+{
+  const struct pdp10_instruction *op;
+  int opcode, flow;
+
+  word &= WORDMASK;
+  opcode = OPCODE (word);
+  *target = (I (word) == 0 && X (word) == 0) ? Y (word) : -1;
+
+  if (opcode == 0)
+    return -1;
+  op = lookup (word, cpu_model);
+  if (op == NULL)
+    return opcode < 0100 ? FLOW_NEXT | FLOW_SKIP : -1;
+
+  flow = 0;
+  if (!(op->type & PDP10_NO_NEXT))
+    flow |= FLOW_NEXT;
+  if (op->type & PDP10_SKIP)
+    flow |= FLOW_SKIP;
+  if (op->type & PDP10_JUMP)
+    flow |= FLOW_JUMP;
+  if (op->type & PDP10_CALL)
+    flow |= FLOW_CALL;
+  if (op->type & PDP10_XCT)
+    flow |= FLOW_EXECUTE;
+  if ((op->type & PDP10_STORE_PC) && *target != -1)
+    *target = (*target + 1) & 0777777;
+  return flow;
+}
+
+static void disassemble (struct text *t, struct pdp10_memory *memory,
+			 word_t word, int address, int cpu_model);
+static void comment (struct text *t, word_t word);
+
+int dis_format = DIS_TEXT;
+
+static int
+out_decimal (struct text *t, long long x)
+{
+  char buffer[24];
+  snprintf (buffer, sizeof buffer, "%lld", x);
+  return out_string (t, buffer);
+}
+
+static void
+out_json_string (struct text *t, const char *s)
+{
+  if (s == NULL)
+    {
+      out_string (t, "null");
+      return;
+    }
+
+  out_char (t, '"');
+  for (; *s; s++)
+    {
+      if (*s == '"' || *s == '\\')
+	out_char (t, '\\');
+      if ((unsigned char)*s < 040)
+	{
+	  out_string (t, "\\u00");
+	  out_char (t, "0123456789abcdef"[(*s >> 4) & 15]);
+	  out_char (t, "0123456789abcdef"[*s & 15]);
+	}
+      else
+	out_char (t, *s);
+    }
+  out_char (t, '"');
+}
+
 void
-dis (struct pdp10_memory *memory, int cpu_model)
+print_json_string (FILE *f, const char *s)
+{
+  struct text t = { NULL, 0, 0 };
+  out_json_string (&t, s);
+  fwrite (t.data, 1, t.length, f);
+  free (t.data);
+}
+
+static void
+out_json_number (struct text *t, const char *key, long long x, int valid)
+{
+  out_string (t, ",\"");
+  out_string (t, key);
+  out_string (t, "\":");
+  if (valid)
+    out_decimal (t, x);
+  else
+    out_string (t, "null");
+}
+
+static const char *
+symbol_name (word_t value, int hint)
+{
+  const struct symbol *sym = get_symbol_by_value (value, hint);
+  return sym == NULL ? NULL : sym->name;
+}
+
+/* Write one word as a JSON object on a line of its own.  Numbers are
+   decimal, and missing values are null. */
+static void
+json_word (struct text *t, struct pdp10_memory *memory, word_t word,
+	   int address, int cpu_model, int code)
+{
+  const struct pdp10_instruction *op;
+  const struct its_oper *oper = NULL;
+  const char *mnemonic = NULL;
+  const char *mark = NULL;
+  int e, time;
+
+  if (word & START_TAPE)
+    mark = "tape";
+  else if (word & START_FILE)
+    mark = "file";
+  else if (word & START_RECORD)
+    mark = "record";
+  word &= WORDMASK;
+
+  op = code ? lookup (word, cpu_model) : NULL;
+  if (op != NULL)
+    {
+      mnemonic = op->name;
+      if ((cpu_model & PDP10_ITS) && OPCODE (word) == ITS_OPER)
+	oper = lookup_oper (word, opers, sizeof opers / sizeof opers[0]);
+      else if ((cpu_model & PDP10_SAIL) && OPCODE (word) == CALLI)
+	oper = lookup_oper (word, waits_callis,
+			    sizeof waits_callis / sizeof waits_callis[0]);
+      if (oper != NULL)
+	mnemonic = oper->name;
+    }
+
+  out_string (t, "{\"address\":");
+  if (address == -1)
+    out_string (t, "null");
+  else
+    out_decimal (t, address);
+  out_json_number (t, "word", word, 1);
+  out_string (t, ",\"mark\":");
+  out_json_string (t, mark);
+  out_string (t, ",\"label\":");
+  out_json_string (t, symbol_name (address, HINT_ADDRESS));
+  if (dis_code)
+    out_string (t, code ? ",\"code\":true" : ",\"code\":false");
+  out_string (t, ",\"mnemonic\":");
+  out_json_string (t, mnemonic);
+  out_json_number (t, "a", A (word), 1);
+  out_json_number (t, "i", I (word), 1);
+  out_json_number (t, "x", X (word), 1);
+  out_json_number (t, "y", Y (word), 1);
+  out_string (t, ",\"y_symbol\":");
+  out_json_string (t, symbol_name (Y (word), HINT_ADDRESS));
+  e = memory == NULL || !code ? -1 : calc_e (memory, word);
+  out_json_number (t, "e", e, e != -1);
+  time = instruction_time (word, PDP10_KA10);
+  out_json_number (t, "ka10_ns", time, op != NULL && time > 0);
+  time = instruction_time (word, PDP10_KI10);
+  out_json_number (t, "ki10_ns", time, op != NULL && time > 0);
+  out_string (t, "}\n");
+}
+
+/* With dis_xref set, the addresses used by each instruction are
+   collected while disassembling: the Y field, and the effective address
+   if it's different, when they are used as addresses.  There is a list
+   for each thread, or with several threads for each chunk.  The lists
+   are kept in the file context until write_xref sorts them. */
+int dis_xref = 0;
+static __thread struct reference_list *xref_list = NULL;
+
+static struct reference_list *
+new_xref_list (void)
+{
+  struct file_context *c = file_context;
+
+  c->xref = realloc (c->xref, (c->xrefs + 1) * sizeof *c->xref);
+  if (c->xref == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  memset (&c->xref[c->xrefs], 0, sizeof *c->xref);
+  return &c->xref[c->xrefs++];
+}
+
+/* Is the effective address of an instruction a number, rather than
+   the address of an operand? */
+static int
+immediate_operand (const struct pdp10_instruction *op, word_t word)
+{
+  int opcode = OPCODE (word);
+
+  /* CONO, CONSZ, and CONSO. */
+  if (op->type & PDP10_IO)
+    return (A (word) & 7) == 4 || (A (word) & 7) >= 6;
+  if (op->addr_hint == HINT_IMMEDIATE || op->addr_hint == HINT_FLOAT ||
+      op->addr_hint == HINT_NUMBER)
+    return 1;
+  /* Shifts and rotates, but not JFFO. */
+  return opcode >= 0240 && opcode <= 0246 && opcode != 0243;
+}
+
+static void
+xref_word (struct pdp10_memory *memory, word_t word, int address,
+	   int cpu_model)
+{
+  const struct pdp10_instruction *op;
+  int e, immediate;
+
+  word &= WORDMASK;
+  if (xref_list == NULL || address == -1)
+    return;
+  op = lookup (word, cpu_model);
+  if (op == NULL || (op->type & PDP10_E_UNUSED))
+    return;
+
+  /* An immediate operand only reads memory through an indirect word,
+     and with an index register a small Y is an offset. */
+  immediate = immediate_operand (op, word);
+  if ((!immediate || I (word)) && (X (word) == 0 || Y (word) >= 020))
+    add_reference (xref_list, Y (word), address);
+  if (!immediate && I (word) && memory != NULL)
+    {
+      /* An indirect word of zero is most likely set at run time. */
+      e = calc_e (memory, word);
+      if (e != -1 && e != 0 && e != Y (word))
+	add_reference (xref_list, e, address);
+    }
+}
+
+static int
+compare_symbols (const void *a, const void *b)
+{
+  const struct symbol *x = *(const struct symbol **)a;
+  const struct symbol *y = *(const struct symbol **)b;
+  int n = strcmp (x->name, y->name);
+  if (n != 0)
+    return n;
+  return x->value < y->value ? -1 : x->value > y->value;
+}
+
+/* Write the references to each symbol, in name order. */
+void
+write_xref (FILE *f)
+{
+  struct pdp10_references references;
+  struct text t = { NULL, 0, 0 };
+  const struct symbol **sorted;
+  const int *from;
+  int i, j, n, m;
+
+  sort_references (&references, file_context->xref, file_context->xrefs);
+  free (file_context->xref);
+  file_context->xref = NULL;
+  file_context->xrefs = 0;
+  xref_list = NULL;
+
+  sorted = malloc (symbol_table->count * sizeof *sorted + 1);
+  if (sorted == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  for (i = m = 0; i < symbol_table->count; i++)
+    if (symbol_table->symbol[i].value <= 0777777)
+      sorted[m++] = &symbol_table->symbol[i];
+  qsort (sorted, m, sizeof *sorted, compare_symbols);
+
+  if (dis_format != DIS_JSON)
+    out_string (&t, "\nCross references:\n\n");
+
+  for (i = 0; i < m; i++)
+    {
+      from = get_references (&references, sorted[i]->value, &n);
+      if (n == 0)
+	continue;
+
+      if (dis_format == DIS_JSON)
+	{
+	  out_string (&t, "{\"symbol\":");
+	  out_json_string (&t, sorted[i]->name);
+	  out_json_number (&t, "value", sorted[i]->value, 1);
+	  out_string (&t, ",\"references\":[");
+	  for (j = 0; j < n; j++)
+	    {
+	      if (j > 0)
+		out_char (&t, ',');
+	      out_decimal (&t, from[j]);
+	    }
+	  out_string (&t, "]}\n");
+	}
+      else
+	{
+	  out_field (&t, sorted[i]->name, 10);
+	  out_char (&t, ' ');
+	  out_octal (&t, sorted[i]->value, 6);
+	  out_char (&t, ' ');
+	  for (j = 0; j < n; j++)
+	    {
+	      if (j > 0 && j % 8 == 0)
+		{
+		  out_char (&t, '\n');
+		  spaces (&t, 18);
+		}
+	      out_char (&t, ' ');
+	      out_octal (&t, from[j], 6);
+	    }
+	  out_char (&t, '\n');
+	}
+
+      if (t.length >= FLUSH_SIZE)
+	{
+	  fwrite (t.data, 1, t.length, f);
+	  t.length = 0;
+	}
+    }
+
+  fwrite (t.data, 1, t.length, f);
+  free (t.data);
+  free (sorted);
+  free_references (&references);
+}
+
+/* With dis_code set, only the words found by discover_code are
+   disassembled.  The rest are printed as data, and a run of the same
+   data word is printed once. */
+int dis_code = 0;
+
+static int
+repeated (struct pdp10_memory *memory, word_t word, int address)
+{
+  return get_word_at (memory, address) == word
+    && get_word_at (memory, address - 1) == word
+    && !code_word_at (memory, address)
+    && !code_word_at (memory, address - 1)
+    && get_symbol_by_value (address, HINT_ADDRESS) == NULL;
+}
+
+static void
+dis_data (struct text *t, struct pdp10_memory *memory, word_t word,
+	  int address)
+{
+  const struct symbol *sym;
+  int n;
+
+  if (repeated (memory, word, address))
+    return;
+
+  sym = get_symbol_by_value (address, HINT_ADDRESS);
+  if (sym != NULL)
+    {
+      out_string (t, sym->name);
+      out_string (t, ":\n");
+    }
+
+  out_octal (t, address, 6);
+  out_string (t, ":  ");
+  out_octal (t, word & WORDMASK, 12);
+  out_string (t, "  ");
+  comment (t, word & WORDMASK);
+  out_char (t, '\n');
+
+  for (n = 0; repeated (memory, word, address + n + 1); n++)
+    ;
+  if (n > 0)
+    {
+      spaces (t, 9);
+      out_string (t, "... ");
+      out_decimal (t, n);
+      out_string (t, " more\n");
+    }
+}
+
+static void
+dis_word (struct text *t, struct pdp10_memory *memory, word_t word,
+	  int address, int cpu_model)
 {
   word_t mask = 0777777777777LL;
+  int code;
+
+  code = !dis_code || address == -1 || code_word_at (memory, address);
+  if (code)
+    xref_word (memory, word, address, cpu_model);
+
+  if (dis_format == DIS_JSON)
+    {
+      json_word (t, memory, word, address, cpu_model, code);
+      return;
+    }
+
+  if (word & START_TAPE)
+    out_string (t, "Logical end of tape.\n");
+  else if (word & START_FILE)
+    out_string (t, "Start of file.\n");
+  else if (word & START_RECORD)
+    out_string (t, "Start of record.\n");
+  if (code)
+    disassemble (t, memory, word & mask, address, cpu_model);
+  else
+    dis_data (t, memory, word, address);
+}
+
+/* With several threads, memory is split into chunks which are
+   disassembled into separate buffers.  The calling thread writes them
+   out in order as they are finished.  The workers use the symbols and
+   file context of the calling thread. */
+#define CHUNK_WORDS 4096
+
+struct chunk
+{
+  int start, end;
+  int done;
+  struct text text;
+  struct reference_list *xref;
+};
+
+struct dis_job
+{
+  struct chunk *chunks;
+  int num_chunks;
+  int next_chunk;
+  struct pdp10_memory *memory;
+  int cpu_model;
+  struct symbol_table *symbols;
+  struct file_context *context;
+  pthread_mutex_t lock;
+  pthread_cond_t done;
+};
+
+int dis_threads = 1;
+
+static void *
+dis_worker (void *arg)
+{
+  struct dis_job *job = arg;
+  struct chunk *c;
+  int address;
+  word_t word;
+
+  symbol_table = job->symbols;
+  file_context = job->context;
+
+  for (;;)
+    {
+      pthread_mutex_lock (&job->lock);
+      c = job->next_chunk < job->num_chunks
+	? &job->chunks[job->next_chunk++] : NULL;
+      pthread_mutex_unlock (&job->lock);
+      if (c == NULL)
+	return NULL;
+
+      xref_list = c->xref;
+      for (address = c->start; address < c->end; address++)
+	{
+	  word = get_word_at (job->memory, address);
+	  dis_word (&c->text, job->memory, word, address, job->cpu_model);
+	}
+
+      pthread_mutex_lock (&job->lock);
+      c->done = 1;
+      pthread_cond_broadcast (&job->done);
+      pthread_mutex_unlock (&job->lock);
+    }
+}
+
+static void
+dis_parallel (struct pdp10_memory *memory, int cpu_model)
+{
+  struct dis_job job;
+  pthread_t *threads;
+  int i, address, end;
+
+  job.num_chunks = 0;
+  for (i = 0; i < memory->areas; i++)
+    job.num_chunks += (memory->area[i].end - memory->area[i].start
+		       + CHUNK_WORDS - 1) / CHUNK_WORDS;
+
+  job.chunks = calloc (job.num_chunks, sizeof *job.chunks);
+  threads = malloc (dis_threads * sizeof *threads);
+  if ((job.num_chunks > 0 && job.chunks == NULL) || threads == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+
+  job.num_chunks = 0;
+  for (i = 0; i < memory->areas; i++)
+    for (address = memory->area[i].start; address < memory->area[i].end;
+	 address = end)
+      {
+	end = address + CHUNK_WORDS;
+	if (end > memory->area[i].end)
+	  end = memory->area[i].end;
+	job.chunks[job.num_chunks].start = address;
+	job.chunks[job.num_chunks].end = end;
+	job.num_chunks++;
+      }
+
+  if (dis_xref)
+    {
+      /* Make the lists before the workers start, since new_xref_list
+	 may move them. */
+      for (i = 0; i < job.num_chunks; i++)
+	new_xref_list ();
+      for (i = 0; i < job.num_chunks; i++)
+	job.chunks[i].xref = &file_context->xref[file_context->xrefs
+						 - job.num_chunks + i];
+    }
+
+  job.next_chunk = 0;
+  job.memory = memory;
+  job.cpu_model = cpu_model;
+  job.symbols = symbol_table;
+  job.context = file_context;
+  pthread_mutex_init (&job.lock, NULL);
+  pthread_cond_init (&job.done, NULL);
+  for (i = 0; i < dis_threads; i++)
+    {
+      if (pthread_create (&threads[i], NULL, dis_worker, &job) != 0)
+	{
+	  fprintf (stderr, "Error creating thread.\n");
+	  exit (1);
+	}
+    }
+
+  for (i = 0; i < job.num_chunks; i++)
+    {
+      pthread_mutex_lock (&job.lock);
+      while (!job.chunks[i].done)
+	pthread_cond_wait (&job.done, &job.lock);
+      pthread_mutex_unlock (&job.lock);
+      flush_text (&job.chunks[i].text);
+      free (job.chunks[i].text.data);
+    }
+
+  for (i = 0; i < dis_threads; i++)
+    pthread_join (threads[i], NULL);
+
+  pthread_mutex_destroy (&job.lock);
+  pthread_cond_destroy (&job.done);
+  free (threads);
+  free (job.chunks);
+}
+
+void
+dis (struct pdp10_memory *memory, int cpu_model)
+{
   word_t word;
 
+  if (dis_code)
+    discover_code (memory, cpu_model);
+
+  if (dis_threads > 1)
+    {
+      dis_parallel (memory, cpu_model);
+      return;
+    }
+
+  xref_list = dis_xref ? new_xref_list () : NULL;
   set_address (memory, -1);
   while ((word = get_next_word (memory)) != -1)
     {
-      if (word & START_TAPE)
-	fprintf (output_file, "Logical end of tape.\n");
-      else if (word & START_FILE)
-	fprintf (output_file, "Start of file.\n");
-      else if (word & START_RECORD)
-	fprintf (output_file, "Start of record.\n");
-      disassemble_word (memory, word & mask, get_address (memory), cpu_model);
+      dis_word (&text, memory, word, get_address (memory), cpu_model);
+      if (text.length >= FLUSH_SIZE)
+	flush_text (&text);
     }
+  flush_text (&text);
 }
 
-int
-print_val (const char *format, int field, int hint)
+static int
+print_val (struct text *t, const char *format, int field, int hint)
 {
   const char *p;
   const struct symbol *sym;
@@ -406,13 +1192,13 @@ print_val (const char *format, int field, int hint)
 
 	  sym = get_symbol_by_value (field, hint);
 	  if (sym == NULL)
-	    n += fprintf (output_file, "%o", field);
+	    n += out_octal (t, (unsigned)field, 0);
 	  else
-	    n += fprintf (output_file, "%s", sym->name);
+	    n += out_string (t, sym->name);
 	}
       else
 	{
-	  n += fprintf (output_file, "%c", *p);
+	  n += out_char (t, *p);
 	}
     }
 
@@ -448,26 +1234,156 @@ static double immediate_float (word_t x)
   return (sign ? -1.0 : 1.0) * (double)fraction * exp;
 }
 
+/* Print a word as characters, after the instruction or data. */
+static void
+comment (struct text *t, word_t word)
+{
+  int printable;
+  char ch[5];
+  int i;
+
+#if 1
+  /* Print word as six SIXBIT characters. */
+  {
+    char *p = reserve (t, 9);
+    p[0] = ';';
+    p[1] = '"';
+    for (i = 0; i < 6; i++)
+      p[i + 2] = ((word >> (6 * (5 - i))) & 077) + ' ';
+    p[8] = '"';
+    t->length += 9;
+  }
+#endif
+
+#if 1
+  /* Print word as five ASCII characters, if it seems likely to be a
+   * printable string. */
+  printable = 1;
+  for (i = 0; i < 5; i++)
+    {
+      ch[i] = (word >> (((4 - i) * 7) + 1)) & 0177;
+      switch (ch[i])
+	{
+	case '\0':
+	case '\t':
+	case '\n':
+	case '\f':
+	case '\r':
+	case '\033':
+	  break;
+	default:
+	  if (ch[i] < 040 || ch[i] > 0176)
+	    printable = 0;
+	  break;
+	}
+    }
+
+  if ((word & 1) == 1 ||
+      word == 0 ||
+      word == POPJ_17)
+    printable = 0;
+
+  {
+    int seen_nonzero = 0;
+    for (i = 4; i >= 0; i--)
+      {
+	if (ch[i] == 0)
+	  {
+	    if (seen_nonzero)
+	      printable = 0;
+	  }
+	else
+	  seen_nonzero = 1;
+      }
+  }
+
+  if (printable)
+    {
+      out_string (t, " \"");
+      for (i = 0; i < 5; i++)
+	{
+	  switch (ch[i])
+	    {
+	    case '\0':
+	      out_string (t, "\\0");
+	      break;
+	    case '\t':
+	      out_string (t, "\\t");
+	      break;
+	    case '\n':
+	      out_string (t, "\\n");
+	      break;
+	    case '\f':
+	      out_string (t, "\\f");
+	      break;
+	    case '\r':
+	      out_string (t, "\\r");
+	      break;
+	    case '\\':
+	      out_string (t, "\\\\");
+	      break;
+	    case '\"':
+	      out_string (t, "\\\"");
+	      break;
+	    default:
+	      if (ch[i] < 040 || ch[i] > 0176)
+		{
+		  out_char (t, '\\');
+		  out_octal (t, ch[i], 3);
+		}
+	      else
+		out_char (t, ch[i]);
+	      break;
+	    }
+	}
+      out_char (t, '"');
+    }
+#endif
+
+#if 0
+  /* Print word as six SQUOZE characters. */
+  squoze_to_ascii (word, ch);
+  out_string (t, " \"");
+  out_string (t, ch);
+  out_char (t, '"');
+#endif
+
+}
+
 void
 disassemble_word (struct pdp10_memory *memory, word_t word,
 		  int address, int cpu_model)
+{
+  disassemble (&text, memory, word, address, cpu_model);
+  flush_text (&text);
+}
+
+static void
+disassemble (struct text *t, struct pdp10_memory *memory, word_t word,
+	     int address, int cpu_model)
 {
   const struct symbol *sym;
   const struct pdp10_instruction *op;
-  int printable, hint;
-  char ch[5];
-  int i, n;
+  int hint;
+  int n;
 
   sym = get_symbol_by_value (address, HINT_ADDRESS);
   if (sym != NULL)
-    fprintf (output_file, "%s:\n", sym->name);
+    {
+      out_string (t, sym->name);
+      out_string (t, ":\n");
+    }
 
   if (address == -1)
-    fprintf (output_file, "         ");
+    out_string (t, "         ");
   else
-    fprintf (output_file, "%06o:  ", address);
+    {
+      out_octal (t, address, 6);
+      out_string (t, ":  ");
+    }
 
-  fprintf (output_file, "%012llo  ", word);
+  out_octal (t, word, 12);
+  out_string (t, "  ");
 
   n = 0;
 
@@ -479,14 +1395,17 @@ disassemble_word (struct pdp10_memory *memory, word_t word,
 	  /* If no opcode found and left half is 0, print as symbol. */
 	  sym = get_symbol_by_value (Y (word), HINT_ADDRESS);
 	  if (sym != NULL)
-	    n += fprintf (output_file, "%s", sym->name);
+	    n += out_string (t, sym->name);
 	}
       else if ((word >> 18) != 0 && Y (word))
 	{
 	  /* No opcode found and right half is 0, print as symbol. */
 	  sym = get_symbol_by_value (word >> 18, HINT_ADDRESS);
 	  if (sym != NULL)
-	    n += fprintf (output_file, "%s,,", sym->name);
+	    {
+	      n += out_string (t, sym->name);
+	      n += out_string (t, ",,");
+	    }
 	}
     }
   else if ((cpu_model & PDP10_ITS) && OPCODE (word) == ITS_OPER)
@@ -495,9 +1414,10 @@ disassemble_word (struct pdp10_memory *memory, word_t word,
       oper = lookup_oper (word, opers, sizeof opers / sizeof opers[0]);
       if (oper)
 	{
-	  n += fprintf (output_file, "%-8s ", oper->name);
+	  n += out_field (t, oper->name, 8);
+	  n += out_char (t, ' ');
 	  if (oper->hint == HINT_CHANNEL || A (word) != 0)
-	    n += print_val ("%o,", A (word), oper->hint);
+	    n += print_val (t, "%o,", A (word), oper->hint);
 	}
     }
   else if ((cpu_model & PDP10_SAIL) && OPCODE (word) == CALLI)
@@ -507,9 +1427,10 @@ disassemble_word (struct pdp10_memory *memory, word_t word,
 			   sizeof waits_callis / sizeof waits_callis[0]);
       if (calli)
 	{
-	  n += fprintf (output_file, "%-8s ", calli->name);
+	  n += out_field (t, calli->name, 8);
+	  n += out_char (t, ' ');
 	  if (calli->hint == HINT_CHANNEL || A (word) != 0)
-	    n += print_val ("%o,", A (word), calli->hint);
+	    n += print_val (t, "%o,", A (word), calli->hint);
 	}
     }
 #if 1
@@ -517,17 +1438,18 @@ disassemble_word (struct pdp10_memory *memory, word_t word,
     {
       int address;
       
-      n += fprintf (output_file, "%-8s ", ".call");
+      n += out_field (t, ".call", 8);
+      n += out_char (t, ' ');
 
       address = calc_e (memory, word);
       if (address == -1 ||
 	  get_word_at (memory, address) != SETZ)
 	{
 	  if (I (word))
-	    n += fprintf (output_file, "@");
-	  n += print_val ("%o", Y (word), HINT_ADDRESS);
+	    n += out_char (t, '@');
+	  n += print_val (t, "%o", Y (word), HINT_ADDRESS);
 	  if (X (word))
-	    n += print_val ("(%o)", X (word), HINT_ACCUMULATOR);
+	    n += print_val (t, "(%o)", X (word), HINT_ACCUMULATOR);
 	}
       else
 	{
@@ -536,189 +1458,111 @@ disassemble_word (struct pdp10_memory *memory, word_t word,
 	  word_t w;
 
 	  n = 0;
-	  fprintf (output_file, "[setz\n");
+	  out_string (t, "[setz\n");
 	  w = get_word_at (memory, address + 1);
 	  sixbit_to_ascii (w, name);
-	  fprintf (output_file, "                                 SIXBIT/%s/\n", name);
+	  spaces (t, 33);
+	  out_string (t, "SIXBIT/");
+	  out_string (t, name);
+	  out_string (t, "/\n");
 	  i = 2;
 	  while (((w = get_word_at (memory, address + i)) & SIGNBIT) == 0)
 	    {
-	      fprintf (output_file, "                                 %012llo\n", w);
+	      spaces (t, 33);
+	      out_octal (t, w, 12);
+	      out_char (t, '\n');
 	      i++;
 	    }
-	  fprintf (output_file, "                                 %012llo]\n", w);
-	  fprintf (output_file, "                       ");
+	  spaces (t, 33);
+	  out_octal (t, w, 12);
+	  out_string (t, "]\n");
+	  spaces (t, 23);
 	}
     }
 #endif
   else
     {
-      n += fprintf (output_file, "%-8s ", op->name);
+      n += out_field (t, op->name, 8);
+      n += out_char (t, ' ');
 
       if (op->type & PDP10_IO)
 	{
 	  const struct pdp10_device *dev;
 	  dev = lookup_device (DEVICE (word), cpu_model);
 	  if (dev != NULL)
-	    n += fprintf (output_file, "%s, ", dev->name);
+	    {
+	      n += out_string (t, dev->name);
+	      n += out_string (t, ", ");
+	    }
 	  else
-	    n += print_val ("%o, ", DEVICE (word), HINT_DEVICE);
+	    n += print_val (t, "%o, ", DEVICE (word), HINT_DEVICE);
 	}
       else if (op->type & PDP10_A_XCTRI)
 	{
 	  hint = op->ac_hint ? op->ac_hint : HINT_ACCUMULATOR;
 	  /* Mask off XCTRI bit in AC field. */
-	  n += print_val ("%o, ", A (word) & ~4, hint);
+	  n += print_val (t, "%o, ", A (word) & ~4, hint);
 	}
       else if (!(op->type & PDP10_A_OPCODE))
 	{
 	  if (A (word) != 0 || !(op->type & PDP10_A_UNUSED))
 	    {
 	      hint = op->ac_hint ? op->ac_hint : HINT_ACCUMULATOR;
-	      n += print_val ("%o, ", A (word), hint);
+	      n += print_val (t, "%o, ", A (word), hint);
 	    }
 	}
 
       if (E (word) != 0 || !(op->type & PDP10_E_UNUSED))
 	{
 	  if (I (word))
-	    n += fprintf (output_file, "@");
+	    n += out_char (t, '@');
 
 	  if (op->addr_hint == HINT_FLOAT && X (word) == 0)
 	    {
 	      const struct symbol *sym = get_symbol_by_value (Y (word), hint);
 	      if (sym == NULL)
-		n += fprintf (output_file, "(%f)", immediate_float (Y (word)));
+		{
+		  char buffer[100];
+		  snprintf (buffer, sizeof buffer, "(%f)",
+			    immediate_float (Y (word)));
+		  n += out_string (t, buffer);
+		}
 	      else
-		n += fprintf (output_file, "%s", sym->name);
+		n += out_string (t, sym->name);
 	    }
 	  else if (Y (word) != 0 && X (word) != 0)
-	    n += print_val ("%o", Y (word), HINT_OFFSET);
+	    n += print_val (t, "%o", Y (word), HINT_OFFSET);
 	  else if (op->addr_hint != 0 && X (word) == 0)
-	    n += print_val ("%o", Y (word), op->addr_hint);
+	    n += print_val (t, "%o", Y (word), op->addr_hint);
 	  else if (Y (word) != 0 ||
 		   (I (word) != 0 && X (word) == 0) ||
 		   (!(op->type & PDP10_E_UNUSED) && X (word) == 0))
-	    n += print_val ("%o", Y (word), HINT_ADDRESS);
+	    n += print_val (t, "%o", Y (word), HINT_ADDRESS);
 
 	  if (X (word))
-	    n += print_val ("(%o)", X (word), HINT_ACCUMULATOR);
+	    n += print_val (t, "(%o)", X (word), HINT_ACCUMULATOR);
 	}
     }
 
-  spaces (25 - n);
+  spaces (t, 25 - n);
 
 #if 0
   /* Print instruction execution time. */
   {
     int t = instruction_time (word, PDP10_KI10);
     if (t > 0)
-      fprintf (output_file, ";%5dns", t);
-    else
-      spaces (8);
-  }
-#endif
-
-#if 1
-  /* Print word as six SIXBIT characters. */
-  fprintf (output_file, ";\"");
-  for (i = 0; i < 6; i++)
-    {
-      int c = (int)(word >> (6 * (5 - i))) & 077;
-      fputc (c + ' ', output_file);
-    }
-  fputc ('"', output_file);
-#endif
-
-#if 1
-  /* Print word as five ASCII characters, if it seems likely to be a
-   * printable string. */
-  printable = 1;
-  for (i = 0; i < 5; i++)
-    {
-      ch[i] = (word >> (((4 - i) * 7) + 1)) & 0177;
-      switch (ch[i])
-	{
-	case '\0':
-	case '\t':
-	case '\n':
-	case '\f':
-	case '\r':
-	case '\033':
-	  break;
-	default:
-	  if (ch[i] < 040 || ch[i] > 0176)
-	    printable = 0;
-	  break;
-	}
-    }
-
-  if ((word & 1) == 1 ||
-      word == 0 ||
-      word == POPJ_17)
-    printable = 0;
-
-  {
-    int seen_nonzero = 0;
-    for (i = 4; i >= 0; i--)
       {
-	if (ch[i] == 0)
-	  {
-	    if (seen_nonzero)
-	      printable = 0;
-	  }
-	else
-	  seen_nonzero = 1;
+	char buffer[20];
+	snprintf (buffer, sizeof buffer, ";%5dns", t);
+	out_string (t, buffer);
       }
+    else
+      spaces (t, 8);
   }
-
-  if (printable)
-    {
-      fprintf (output_file, " \"");
-      for (i = 0; i < 5; i++)
-	{
-	  switch (ch[i])
-	    {
-	    case '\0':
-	      fprintf (output_file, "\\0");
-	      break;
-	    case '\t':
-	      fprintf (output_file, "\\t");
-	      break;
-	    case '\n':
-	      fprintf (output_file, "\\n");
-	      break;
-	    case '\f':
-	      fprintf (output_file, "\\f");
-	      break;
-	    case '\r':
-	      fprintf (output_file, "\\r");
-	      break;
-	    case '\\':
-	      fprintf (output_file, "\\\\");
-	      break;
-	    case '\"':
-	      fprintf (output_file, "\\\"");
-	      break;
-	    default:
-	      if (ch[i] < 040 || ch[i] > 0176)
-		fprintf (output_file, "\\%03o", ch[i]);
-	      else
-		fputc (ch[i], output_file);
-	      break;
-	    }
-	}
-      fprintf (output_file, "\"");
-    }
-#endif
-
-#if 0
-  /* Print word as six SQUOZE characters. */
-  squoze_to_ascii (word, ch);
-  fprintf (output_file, " \"%s\"", ch);
 #endif
 
-  fprintf (output_file, "\n");
+  comment (t, word);
+  out_char (t, '\n');
 }
 
 void
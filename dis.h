@@ -36,8 +36,20 @@
 
 struct pdp10_file;
 struct pdp10_memory;
-extern word_t start_instruction;
-extern FILE *output_file;
+struct reference_list;
+
+/* Precomputed SCRMBL password.  Each of the four steps is an
+   exclusive or followed by a left rotation. */
+struct scramble_key {
+  word_t mask[4];
+  int rotate[4];
+  word_t seed;
+};
+
+extern int dis_threads;
+extern int dis_format;
+extern int dis_xref;
+extern int dis_code;
 
 struct file_format {
   const char *name;
@@ -47,8 +59,42 @@ struct file_format {
 
 enum { SYMBOLS_NONE, SYMBOLS_DDT, SYMBOLS_ALL };
 
-extern struct file_format *input_file_format;
-extern struct file_format *output_file_format;
+enum { DIS_TEXT, DIS_JSON };
+
+/* What dis10 got from loading a file, besides memory and symbols. */
+struct loaded_file {
+  char *text;		/* Text printed by the loader. */
+  size_t text_length;
+  int extra;		/* Number of words after the parsed data. */
+  word_t extra_data;	/* The last of those words. */
+};
+
+#define MAX_ENTRY_POINTS 4
+
+/* Which file formats are used, where information about a file is
+   printed, and what the loader found.  Each thread has a current
+   context, which starts out as a shared default. */
+struct file_context {
+  struct file_format *input_format;
+  struct file_format *output_format;
+  FILE *output;
+  word_t start_instruction;
+  int entry_points;	/* Addresses of code from an entry vector. */
+  int entry_point[MAX_ENTRY_POINTS];
+  struct reference_list *xref;	/* Lists collected for write_xref. */
+  int xrefs;
+};
+
+extern __thread struct file_context *file_context;
+
+
+/* How an instruction passes on control, from instruction_flow. */
+#define FLOW_NEXT	0001	/* May go on to the next word. */
+#define FLOW_SKIP	0002	/* May skip the next word. */
+#define FLOW_JUMP	0004	/* May jump to the target. */
+#define FLOW_CALL	0010	/* Calls the target, and returns to the next. */
+#define FLOW_EXECUTE	0020	/* Executes the target. */
+
 extern struct file_format atari_file_format;
 extern struct file_format cross_file_format;
 extern struct file_format csave_file_format;
@@ -74,6 +120,7 @@ extern struct file_format shr_file_format;
 extern struct file_format simh_file_format;
 extern struct file_format tenex_file_format;
 
+extern void	init_file_context (struct file_context *context);
 extern void     usage_file_format (void);
 extern int      parse_input_file_format (const char *);
 extern int      parse_output_file_format (const char *);
@@ -91,11 +138,17 @@ extern void     dec_info (struct pdp10_memory *memory,
 			  word_t entry_vec_len, word_t entry_vec_addr,
 			  int cpu_model);
 extern void	ntsddt_info (struct pdp10_memory *memory, int);
+extern void	add_entry_point (int address);
 extern void     usage_symbols_mode (void);
 extern int      parse_symbols_mode (const char *string);
 extern void     usage_machine (void);
 extern int      parse_machine (const char *string, int *machine);
 extern void	dis (struct pdp10_memory *memory, int cpu_model);
+extern int	instruction_flow (word_t word, int cpu_model, int *target);
+extern void	discover_code (struct pdp10_memory *memory, int cpu_model);
+extern void	profile (struct pdp10_memory *memory, int cpu_model);
+extern void	write_xref (FILE *f);
+extern void	print_json_string (FILE *f, const char *s);
 extern void	disassemble_word (struct pdp10_memory *memory, word_t word,
 				  int address, int cpu_model);
 extern word_t   ascii_to_sixbit (const char *ascii);
@@ -110,6 +163,20 @@ extern void	timestamp_from_dec (struct tm *tm, word_t timestamp);
 extern int	byte_size (int, int *);
 extern void	scramble (int decrypt, int verbose, word_t password,
 		          const word_t *input, word_t *output, int count);
+extern void	scramble_key (struct scramble_key *key, int decrypt,
+			      word_t password);
+extern word_t	scramble_word (struct scramble_key *key, int decrypt,
+			       word_t word);
+extern void	unscramble_lanes (struct scramble_key *key, int n,
+				  word_t input, word_t *output);
+
+extern unsigned long long cache_key (FILE *f, const char *options);
+extern int	read_cache (const char *dir, unsigned long long key,
+			    struct pdp10_memory *memory,
+			    struct loaded_file *loaded);
+extern void	write_cache (const char *dir, unsigned long long key,
+			     struct pdp10_memory *memory,
+			     const struct loaded_file *loaded);
 
 extern void weenixname (char *);
 extern void weenixpath (char *, word_t, word_t, word_t);
@@ -0,0 +1,249 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Find the words which are instructions, by following the flow of
+   control from the start instruction, the entry vector, and the
+   symbols the loader knows are code.  Other labels are also followed
+   if the words there look like code rather than data.  A word which
+   isn't an instruction ends the path.  Every word reached is marked
+   as code in memory, and the rest is taken to be data.  The words
+   still to look at are kept on a stack, since a run of instructions
+   can be very long.  If that finds almost nothing, the program is
+   probably not one discovery understands, and everything is taken to
+   be code. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dis.h"
+#include "memory.h"
+#include "symbols.h"
+#include "opcode/pdp10.h"
+
+#define OPCODE(word)	(int)(((word) >> 27) &    0777)
+#define I(word)		(int)(((word) >> 22) &       1)
+#define X(word)		(int)(((word) >> 18) &     017)
+#define Y(word)		(int)( (word)        & 0777777)
+
+/* How long a jump table can be. */
+#define MAX_TABLE 512
+
+/* How many words at a label are looked at to see if it's code. */
+#define PLAUSIBLE 4
+
+/* Discovery has failed if it finds less than one word in this many
+   to be code. */
+#define TOO_FEW 32
+
+struct work
+{
+  int *address;
+  int count, size;
+};
+
+static void
+push (struct work *work, int address)
+{
+  if (work->count == work->size)
+    {
+      work->size = work->size ? 2 * work->size : 1024;
+      work->address = realloc (work->address,
+			       work->size * sizeof *work->address);
+      if (work->address == NULL)
+	{
+	  fprintf (stderr, "Out of memory.\n");
+	  exit (1);
+	}
+    }
+  work->address[work->count++] = address;
+}
+
+/* Push the words an instruction at an address may lead to.  Jumps
+   stay in the same section. */
+static void
+push_flow (struct work *work, int address, int flow, int target)
+{
+  if (flow & FLOW_NEXT)
+    push (work, address + 1);
+  if (flow & FLOW_SKIP)
+    push (work, address + 2);
+  if ((flow & (FLOW_JUMP | FLOW_CALL | FLOW_EXECUTE)) && target != -1)
+    push (work, (address & ~0777777) | target);
+}
+
+/* A jump through memory, like JRST @TABLE(A) or PUSHJ P,@FOO, goes
+   to the addresses in the words it reads.  With an index register, the
+   table ends at the first word which isn't a plain address.  A jump
+   into a table, like JRST TABLE(A), goes to a table of jumps.  JSR
+   and JSA store the return address in the first word. */
+static void
+push_table (struct pdp10_memory *memory, int cpu_model, struct work *work,
+	    int address, word_t word)
+{
+  int section = address & ~0777777;
+  int n, flow, target, store;
+  word_t entry;
+
+  store = OPCODE (word) == 0264 || OPCODE (word) == 0266;
+
+  for (n = 0; n < MAX_TABLE; n++)
+    {
+      entry = get_word_at (memory, section | ((Y (word) + n) & 0777777));
+      if (entry == -1)
+	return;
+      if (I (word))
+	{
+	  if (I (entry) || X (entry) || Y (entry) == 0)
+	    return;
+	  push (work, section | ((Y (entry) + store) & 0777777));
+	}
+      else
+	{
+	  flow = instruction_flow (entry, cpu_model, &target);
+	  if (flow != FLOW_JUMP || target == -1)
+	    return;
+	  push (work, section | ((Y (word) + n) & 0777777));
+	}
+      if (X (word) == 0)
+	return;
+    }
+}
+
+/* Return the number of words newly marked as code. */
+static int
+descend (struct pdp10_memory *memory, int cpu_model, struct work *work)
+{
+  int address, flow, target, n = 0;
+  word_t word;
+
+  while (work->count > 0)
+    {
+      address = work->address[--work->count];
+      if (code_word_at (memory, address))
+	continue;
+      word = get_word_at (memory, address);
+      /* A word of all ones is more likely data than a CONSO. */
+      if (word == -1 || word == WORDMASK)
+	continue;
+      flow = instruction_flow (word, cpu_model, &target);
+      if (flow == -1)
+	continue;
+      n += mark_code (memory, address);
+      push_flow (work, address, flow, target);
+      if ((flow & (FLOW_JUMP | FLOW_CALL | FLOW_EXECUTE)) && target == -1)
+	push_table (memory, cpu_model, work, address, word);
+    }
+
+  return n;
+}
+
+/* Five 7-bit characters of printable text, or padding. */
+static int
+text_word (word_t word)
+{
+  int i, c;
+
+  if (word & 1)
+    return 0;
+  for (i = 1; i <= 5; i++)
+    {
+      c = (word >> (36 - 7 * i)) & 0177;
+      if (c == 0177 || (c < 040 && c != 0 && (c < 011 || c > 015)))
+	return 0;
+    }
+  return 1;
+}
+
+/* Does a label look like the start of some code?  The words there
+   must be in memory and decode as instructions, up to the first one
+   which doesn't go on to the next, and not all be text. */
+static int
+plausible (struct pdp10_memory *memory, int cpu_model, int address)
+{
+  int n, flow, target, text = 1;
+  word_t word;
+
+  for (n = 0; n < PLAUSIBLE; n++)
+    {
+      word = get_word_at (memory, address + n);
+      if (word == -1 && n > 0)
+	break;
+      if (word == -1 || word == WORDMASK)
+	return 0;
+      flow = instruction_flow (word, cpu_model, &target);
+      if (flow == -1)
+	return 0;
+      text &= text_word (word);
+      if (!(flow & FLOW_NEXT))
+	break;
+    }
+
+  return !text;
+}
+
+static void
+mark_all (struct pdp10_memory *memory)
+{
+  int i, address;
+
+  for (i = 0; i < memory->areas; i++)
+    for (address = memory->area[i].start;
+	 address < memory->area[i].end;
+	 address++)
+      mark_code (memory, address);
+}
+
+void
+discover_code (struct pdp10_memory *memory, int cpu_model)
+{
+  struct work work = { NULL, 0, 0 };
+  int i, flow, target, words, code;
+  const struct symbol *sym;
+
+  if (file_context->start_instruction != 0)
+    {
+      flow = instruction_flow (file_context->start_instruction, cpu_model,
+			       &target);
+      if (flow > 0)
+	push_flow (&work, 0, flow & ~(FLOW_NEXT | FLOW_SKIP), target);
+    }
+
+  for (i = 0; i < file_context->entry_points; i++)
+    push (&work, file_context->entry_point[i]);
+
+  /* ITS takes a user interrupt by executing location 42. */
+  if (cpu_model & PDP10_ITS)
+    push (&work, 042);
+
+  /* Labels in the accumulators are more likely their names. */
+  for (i = 0; i < symbol_table->count; i++)
+    {
+      sym = &symbol_table->symbol[i];
+      if (sym->value < 020 || sym->value >= (1 << MEMORY_ADDRESS_BITS))
+	continue;
+      if ((sym->flags & SYMBOL_CODE) ||
+	  plausible (memory, cpu_model, sym->value))
+	push (&work, sym->value);
+    }
+
+  code = descend (memory, cpu_model, &work);
+  free (work.address);
+
+  words = 0;
+  for (i = 0; i < memory->areas; i++)
+    words += memory->area[i].end - memory->area[i].start;
+  if ((long long)code * TOO_FEW < words)
+    mark_all (memory);
+}
@@ -22,7 +22,7 @@
 static void
 read_dmp (FILE *f, struct pdp10_memory *memory, int cpu_model)
 {
-  fprintf (output_file, "DMP format\n");
+  fprintf (file_context->output, "DMP format\n");
 
   read_raw_at (f, memory, 074);
 
@@ -34,7 +34,7 @@ write_dmp (FILE *f, struct pdp10_memory *memory)
 {
   word_t jbsa = get_word_at (memory, 0120);
   jbsa &= 0777777000000;
-  jbsa |= start_instruction & 0777777;
+  jbsa |= file_context->start_instruction & 0777777;
   set_word_at (memory, 0120, jbsa);
   write_raw_at (f, memory, 074);
 }
@@ -45,30 +45,6 @@ int tutblk;
 int mdnuds;
 char *type;
 
-static int
-get_byte (FILE *f)
-{
-  int c = fgetc (f);
-  return c == EOF ? -1 : c;
-}
-
-static word_t get_disk_word (FILE *f)
-{
-  int i, x;
-  word_t w = 0;
-
-  for (i = 0; i < 8; i++)
-    {
-      x = get_byte (f);
-      if (x == -1)
-	return -1;
-
-      w += (word_t)x << (i * 8);
-    }
-
-  return w;
-}
-
 static word_t *
 get_block (int block)
 {
@@ -80,13 +56,18 @@ get_block (int block)
 
 static int read_block (FILE *f, word_t *buffer)
 {
-  int i;
+  unsigned char octets[8 * BLOCK_WORDS], *p;
+  int i, j;
+
+  /* Disk words are stored little endian in eight octets. */
+  if (fread (octets, 8, BLOCK_WORDS, f) != BLOCK_WORDS)
+    return -1;
 
-  for (i = 0; i < BLOCK_WORDS; i++)
+  for (i = 0, p = octets; i < BLOCK_WORDS; i++, p += 8)
     {
-      buffer[i] = get_disk_word (f);
-      if (buffer[i] == -1)
-	return -1;
+      buffer[i] = 0;
+      for (j = 0; j < 8; j++)
+	buffer[i] += (word_t)p[j] << (j * 8);
     }
 
   return 0;
@@ -341,7 +322,7 @@ main (int argc, char **argv)
       exit (1);
     }
 
-  output_file = stdout;
+  file_context->output = stdout;
 
   f = fopen (argv[1], "rb");
 
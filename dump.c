@@ -21,7 +21,7 @@ main (int argc, char **argv)
   FILE *file;
   int opt;
 
-  output_file = stderr;
+  file_context->output = stderr;
   file = stdin;
 
   while ((opt = getopt (argc, argv, "W:X:F:O:")) != -1)
@@ -49,13 +49,13 @@ main (int argc, char **argv)
         }
     }
 
-  if (!output_file_format)
+  if (!file_context->output_format)
     usage (argv);
 
-  if (output_file_format->write == NULL)
+  if (file_context->output_format->write == NULL)
     {
       fprintf (stderr, "File format \"%s\" not supported for output\n",
-               output_file_format->name);
+               file_context->output_format->name);
       exit (1);
     }
 
@@ -72,18 +72,19 @@ main (int argc, char **argv)
         }
       optind++;
 
-      if (!input_file_format)
+      if (!file_context->input_format)
         guess_input_file_format (file);
 
-      input_file_format->read (file, &memory, 0);
+      file_context->input_format->read (file, &memory, 0);
       fclose (file);
     }
 
   fprintf (stderr, "Core image address range: %o - %o\n",
            memory.area[0].start, memory.area[memory.areas-1].end);
-  fprintf (stderr, "Writing file format: %s\n", output_file_format->name);
+  fprintf (stderr,
+	   "Writing file format: %s\n", file_context->output_format->name);
 
-  output_file_format->write (stdout, &memory);
+  file_context->output_format->write (stdout, &memory);
   flush_word (stdout);
 
   return 0;
@@ -26,6 +26,7 @@
 #include <sys/types.h>
 #include "dis.h"
 #include "mkdirs.h"
+#include "tape-index.h"
 
 /* Record types. */
 #define DATA  0  /* Contents of file page. */
@@ -66,6 +67,11 @@ static int format;
 static int word_bytes;
 static word_t file_bytes;
 static word_t file_octets;
+static int skip_file;
+static long record_offset;
+static unsigned long record_index;
+static FILE *index_file;
+static struct tape_index tape_index;
 
 /*
 Format:
@@ -405,6 +411,7 @@ read_record (FILE *f, word_t word)
   word_t checksum = 0;
   int i;
 
+  record_offset = tape_record_offset (f, &record_index);
   block[0] = word & 0777777777777LL;
   checksum = sum (checksum, block[0]);
   for (i = 1; i < MAX; i++)
@@ -477,6 +484,20 @@ print_info (FILE *f, word_t *fdb)
 	   file_bytes, bits_per_byte);
 }
 
+/* With no file names on the command line, all files are wanted. */
+static int
+wanted (const char *name)
+{
+  int i;
+
+  if (file_argc == 0)
+    return 1;
+  for (i = 0; i < file_argc; i++)
+    if (strcmp (file_argv[i], name) == 0)
+      return 1;
+  return 0;
+}
+
 static void
 read_file (int offset)
 {
@@ -484,7 +505,7 @@ read_file (int offset)
 
   if (offset != 0206)
     {
-      if (format == 0)
+      if (format == 0 && !skip_file)
 	print_info (stderr, block + offset);
 
       if (output != NULL)
@@ -500,6 +521,13 @@ read_file (int offset)
       if (p)
 	*p = 0;
 
+      if (index_file != NULL)
+	add_tape_index (index_file, file_path, record_offset, record_index);
+
+      skip_file = !wanted (file_path);
+      if (skip_file)
+	return;
+
       fprintf (stderr, " %-40s", file_path);
 
       if (format > 0)
@@ -520,6 +548,41 @@ read_data (void)
     write_word (output, data[i]);
 }
 
+static int
+process_record (void)
+{
+  int type = (01000000000000LL - block[4]) & 0777777777777LL;
+
+  switch (type)
+    {
+    case DATA:
+      read_data ();
+      break;
+    case TPHD:
+      break;
+    case FLHD:
+      read_file (0206);
+      break;
+    case FLTR:
+      read_file (0006);
+      break;
+    case TPTR:
+      break;
+    case USR:
+      break;
+    case CTPH:
+      break;
+    case FILL:
+      break;
+    default:
+      fprintf (stderr, "Uknown record type.\n");
+      exit (1);
+      break;
+    }
+
+  return type;
+}
+
 static void
 read_tape (FILE *f)
 {
@@ -531,33 +594,76 @@ read_tape (FILE *f)
   while (word != -1)
     {
       word = read_record (f, word);
-      switch ((01000000000000LL - block[4]) & 0777777777777LL)
-	{
-	case DATA:
-	  read_data ();
-	  break;
-	case TPHD:
-	  break;
-	case FLHD:
-	  read_file (0206);
-	  break;
-	case FLTR:
-	  read_file (0006);
-	  break;
-	case TPTR:
-	  break;
-	case USR:
-	  break;
-	case CTPH:
-	  break;
-	case FILL:
-	  break;
-	default:
-	  fprintf (stderr, "Uknown record type.\n");
-	  exit (1);
+      process_record ();
+    }
+
+  if (index_file != NULL)
+    finish_tape_index (index_file);
+}
+
+static int
+compare_offsets (const void *a, const void *b)
+{
+  const struct tape_index_entry *x = *(const struct tape_index_entry **)a;
+  const struct tape_index_entry *y = *(const struct tape_index_entry **)b;
+  return x->offset < y->offset ? -1 : x->offset > y->offset;
+}
+
+/* Go straight to each file named on the command line, using the
+   index.  A name may be on the tape more than once, so every copy is
+   extracted, in the order they are on the tape. */
+static void
+read_indexed (FILE *f)
+{
+  const struct tape_index_entry *e, *end, **files;
+  word_t word;
+  int i, j, n = 0;
+
+  files = malloc (tape_index.count * sizeof *files);
+  if (files == NULL && tape_index.count > 0)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+
+  end = tape_index.entry + tape_index.count;
+  for (i = 0; i < file_argc; i++)
+    {
+      for (j = 0; j < i; j++)
+	if (strcmp (file_argv[j], file_argv[i]) == 0)
 	  break;
+      if (j < i)
+	continue;
+
+      e = find_tape_index (&tape_index, file_argv[i]);
+      if (e == NULL)
+	{
+	  fprintf (stderr, "%s: not in the index.\n", file_argv[i]);
+	  continue;
 	}
+      /* The other copies follow the first. */
+      for (; e < end && strcmp (e->name, file_argv[i]) == 0; e++)
+	files[n++] = e;
     }
+
+  qsort (files, n, sizeof *files, compare_offsets);
+
+  word = get_word (f);
+  read_tape_header (f, word);
+
+  for (i = 0; i < n; i++)
+    {
+      seek_tape_record (f, files[i]->offset, files[i]->record);
+      word = get_word (f);
+      while (word != -1)
+	{
+	  word = read_record (f, word);
+	  if (process_record () == FLTR)
+	    break;
+	}
+    }
+
+  free (files);
 }
 
 static void
@@ -728,9 +834,9 @@ write_usr (FILE *f)
 static void
 write_tape (FILE *f)
 {
-  struct word_format *tmp = input_word_format;
-  input_word_format = output_word_format;
-  output_word_format = tmp;
+  struct word_format *tmp = word_context->input_format;
+  word_context->input_format = word_context->output_format;
+  word_context->output_format = tmp;
   int i, bfmsg;
 
   if (f == NULL)
@@ -783,7 +889,8 @@ static void
 usage (const char *x)
 {
   fprintf (stderr,
-	   "Usage: %s -c|-t|-x [-v0123456] [-Wformat] [-Cdir] [-f file]\n", x);
+	   "Usage: %s -c|-t|-x [-v0123456] [-Wformat] [-Cdir] [-Iindex] "
+	   "[-f file] [files...]\n", x);
   usage_word_format ();
   exit (1);
 }
@@ -795,18 +902,28 @@ newline (void)
     fputc ('\n', list);
 }
 
+static void
+report (void)
+{
+  if (word_context->tape.records == 0)
+    return;
+  fputc ('\n', info);
+  report_tape_rate (info);
+}
+
 int
 main (int argc, char **argv)
 {
   void (*process_tape) (FILE *) = NULL;
   char *tape_name = NULL, *mode;
   char *directory = NULL;
+  char *index_name = NULL;
   int verbose = 0;
   FILE *f = NULL;
   int opt;
 
-  input_word_format = &tape_word_format;
-  output_word_format = &aa_word_format;
+  word_context->input_format = &tape_word_format;
+  word_context->output_format = &aa_word_format;
 
   /* If you ask for a file listing with -t or -xv, it's considered the
      output data and written to stdout.  Overriden by -c, see below. */
@@ -821,7 +938,7 @@ main (int argc, char **argv)
   else
     format = 0;
 
-  while ((opt = getopt (argc, argv, "ctvx0123456f:W:C:")) != -1)
+  while ((opt = getopt (argc, argv, "ctvx0123456f:W:C:I:")) != -1)
     {
       switch (opt)
 	{
@@ -878,10 +995,10 @@ main (int argc, char **argv)
 	  format = opt - '0';
 	  break;
 	case '7':
-	  input_word_format = &tape7_word_format;
+	  word_context->input_format = &tape7_word_format;
 	  break;
 	case '9':
-	  input_word_format = &tape_word_format;
+	  word_context->input_format = &tape_word_format;
 	  break;
 	case 'W':
 	  if (parse_output_word_format (optarg))
@@ -896,6 +1013,9 @@ main (int argc, char **argv)
 	    }
 	  directory = optarg;
 	  break;
+	case 'I':
+	  index_name = optarg;
+	  break;
 	default:
 	  usage (argv[0]);
 	}
@@ -917,6 +1037,23 @@ main (int argc, char **argv)
 	       optarg, strerror (errno));
       exit (1);
     }
+  if (tape_name && *mode == 'r')
+    map_word_input (f);
+
+  file_argc = argc - optind;
+  file_argv = argv + optind;
+
+  /* An index which is missing or stale is made while reading the whole
+     tape.  A good one is used to go directly to the named files. */
+  if (index_name != NULL)
+    {
+      if (process_tape != read_tape || tape_name == NULL)
+	usage (argv[0]);
+      if (read_tape_index (&tape_index, index_name, f) == -1)
+	index_file = create_tape_index (index_name, f);
+      else if (file_argc > 0)
+	process_tape = read_indexed;
+    }
 
   if (directory && chdir (directory) == -1)
     {
@@ -925,8 +1062,7 @@ main (int argc, char **argv)
       exit (1);
     }
 
-  file_argc = argc - optind;
-  file_argv = argv + optind;
+  atexit (report);
   atexit (newline);
   process_tape (f);
 
@@ -24,27 +24,28 @@
 #include "dis.h"
 #include "memory.h"
 
+/* Octets left in the current input word. */
+static __thread int octets = 0;
+static __thread word_t octet_word;
+
 static int
 read_8 (FILE *f)
 {
-  static int i = 0;
-  static word_t word;
-
-  if (i == 0)
+  if (octets == 0)
     {
-      word = get_word (f);
-      if (word == -1)
+      octet_word = get_word (f);
+      if (octet_word == -1)
 	return -1;
-      i = 4;
+      octets = 4;
     }
 
-  i--;
-  switch (i)
+  octets--;
+  switch (octets)
     {
-    case 0: return (word >>  8) & 0377;
-    case 1: return (word >>  0) & 0377;
-    case 2: return (word >> 26) & 0377;
-    case 3: return (word >> 18) & 0377;
+    case 0: return (octet_word >>  8) & 0377;
+    case 1: return (octet_word >>  0) & 0377;
+    case 2: return (octet_word >> 26) & 0377;
+    case 3: return (octet_word >> 18) & 0377;
     }
 
   return -1;
@@ -98,7 +99,8 @@ read_exb (FILE *f, struct pdp10_memory *memory, int cpu_model)
 
   (void)cpu_model;
 
-  fprintf (output_file, "EXB format\n");
+  fprintf (file_context->output, "EXB format\n");
+  octets = 0;
 
   for (;;)
     {
@@ -113,8 +115,8 @@ read_exb (FILE *f, struct pdp10_memory *memory, int cpu_model)
 
       if (length == 4)
 	{
-	  fprintf (output_file, "Start address: %06o\n", address);
-	  start_instruction = JRST + address;
+	  fprintf (file_context->output, "Start address: %06o\n", address);
+	  file_context->start_instruction = JRST + address;
 	  return;
 	}
 
@@ -149,8 +151,8 @@ read_exb (FILE *f, struct pdp10_memory *memory, int cpu_model)
 static void
 write_8 (FILE *f, int data)
 {
-  static word_t word = 0;
-  static int i = 0;
+  static __thread word_t word = 0;
+  static __thread int i = 0;
 
   data &= 0377;
   switch (i)
@@ -219,7 +221,7 @@ write_exb (FILE *f, struct pdp10_memory *memory)
       write_block (f, memory, start, length);
     }
 
-  start = start_instruction & 0777777;
+  start = file_context->start_instruction & 0777777;
   if (start)
     write_block (f, memory, start, 0);
 }
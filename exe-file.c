@@ -35,7 +35,7 @@ read_exe (FILE *f, struct pdp10_memory *memory, int cpu_model)
   for (i = 0; i < FILE_MAX_PAGES; i++)
     file_map[i] = -1;
 
-  fprintf (output_file, "DEC sharable format\n\n");
+  fprintf (file_context->output, "DEC sharable format\n\n");
 
   /* Read the directory */
   for (;;)
@@ -51,8 +51,9 @@ read_exe (FILE *f, struct pdp10_memory *memory, int cpu_model)
       switch (block_type)
 	{
 	case 01776: /* directory block */
-	  fprintf (output_file, "Directory:\n");
-	  fprintf (output_file, "Prot  File page  Memory page  Count\n");
+	  fprintf (file_context->output, "Directory:\n");
+	  fprintf (file_context->output,
+		   "Prot  File page  Memory page  Count\n");
 	  for (i = 1; i < block_len; i += 2)
 	    {
 	      word_t access_bits, file_page, mem_page, count;
@@ -69,12 +70,13 @@ read_exe (FILE *f, struct pdp10_memory *memory, int cpu_model)
 	      mem_page = word & ((1 << 27) - 1);
 	      count = (word >> 27) + 1;
 
-	      fprintf (output_file, "%03llo   ", access_bits);
+	      fprintf (file_context->output, "%03llo   ", access_bits);
 	      if (file_page == 0)
-		fprintf (output_file, "none       ");
+		fprintf (file_context->output, "none       ");
 	      else
-		fprintf (output_file, "%09llo  ", file_page);
-	      fprintf (output_file, "%09llo    %llo\n", mem_page, count);
+		fprintf (file_context->output, "%09llo  ", file_page);
+	      fprintf (file_context->output,
+		       "%09llo    %llo\n", mem_page, count);
 
 	      if (file_page != 0)
 		{
@@ -83,11 +85,11 @@ read_exe (FILE *f, struct pdp10_memory *memory, int cpu_model)
 		      if (file_page + j < FILE_MAX_PAGES)
 			file_map[file_page + j] = mem_page + j;
 		      else
-			fprintf (output_file, "  (too many pages; not loaded)\n");
+			fprintf (file_context->output, "  (too many pages; not loaded)\n");
 		    }
 		}
 	    }
-	  fprintf (output_file, "\n");
+	  fprintf (file_context->output, "\n");
 	  break;
 
 	case 01775: /* entry vector block */
@@ -103,7 +105,8 @@ read_exe (FILE *f, struct pdp10_memory *memory, int cpu_model)
 	  goto enddir;
 
 	default:
-	  fprintf (output_file, "Unknown block type %06llo\n\n", block_type);
+	  fprintf (file_context->output,
+		   "Unknown block type %06llo\n\n", block_type);
 	  /* fall through */
 
 	case 01774: /* PDV block - ignore */
@@ -24,12 +24,12 @@
 #define NFASL 0124641635413LL  /* *FASL+ */
 #define OFASL 0124641635412LL  /* *FASL* */
 
-static int atom_index = 1;
-static char *atomtable[1000];
-static int type[1000];
+static __thread int atom_index = 1;
+static __thread char *atomtable[1000];
+static __thread int type[1000];
 
-static int address; //Current absolute address to load into.
-static int offset;  //Relocation offset.
+static __thread int address; //Current absolute address to load into.
+static __thread int offset;  //Relocation offset.
 
 static int
 fasl_magic (word_t word)
@@ -290,7 +290,8 @@ read_block (FILE *f, struct pdp10_memory *memory)
           /*fprintf (stderr, ", address %06llo args %06llo\n",
             value & 0777777, value >> 18);*/
           value = relocate (value & 0777777, offset, 0777777);
-          add_symbol (atomtable[data >> 18], value, SYMBOL_HALFKILLED);
+          add_symbol (atomtable[data >> 18], value,
+                      SYMBOL_HALFKILLED | SYMBOL_CODE);
           break;
         case 014:
           address = relocate (data & 0777777, offset, 0777777);
@@ -333,7 +334,7 @@ read_fasl (FILE *f, struct pdp10_memory *memory, int cpu_model)
 
   (void)cpu_model;
 
-  fprintf (output_file, "FASL format\n");
+  fprintf (file_context->output, "FASL format\n");
 
   word = get_word (f);
   if (!fasl_magic (word))
@@ -344,7 +345,7 @@ read_fasl (FILE *f, struct pdp10_memory *memory, int cpu_model)
 
   word = get_word (f);
   sixbit_to_ascii (word, version);
-  fprintf (output_file, "  Lisp version: %s\n", version);
+  fprintf (file_context->output, "  Lisp version: %s\n", version);
 
   // The conventional starting address.
   offset = 0100;
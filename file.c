@@ -19,9 +19,6 @@
 
 #include "dis.h"
 
-struct file_format *input_file_format = NULL;
-struct file_format *output_file_format = NULL;
-
 static struct file_format *file_formats[] = {
   &atari_file_format,
   &cross_file_format,
@@ -78,15 +75,15 @@ parse_file_format (const char *string)
 int
 parse_input_file_format (const char *string)
 {
-  input_file_format = parse_file_format (string);
-  return input_file_format == NULL ? -1 : 0;
+  file_context->input_format = parse_file_format (string);
+  return file_context->input_format == NULL ? -1 : 0;
 }
 
 int
 parse_output_file_format (const char *string)
 {
-  output_file_format = parse_file_format (string);
-  return output_file_format == NULL ? -1 : 0;
+  file_context->output_format = parse_file_format (string);
+  return file_context->output_format == NULL ? -1 : 0;
 }
 
 void
@@ -96,11 +93,11 @@ guess_input_file_format (FILE *file)
   rewind_word (file);
 
   if ((word >> 18) == 01776)
-    input_file_format = &exe_file_format;
+    file_context->input_format = &exe_file_format;
   else if ((word >> 18) == 01000)
-    input_file_format = &tenex_file_format;
+    file_context->input_format = &tenex_file_format;
   else if (word == 0)
-    input_file_format = &pdump_file_format;
+    file_context->input_format = &pdump_file_format;
   else
-    input_file_format = &sblk_file_format;
+    file_context->input_format = &sblk_file_format;
 }
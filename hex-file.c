@@ -18,7 +18,7 @@
 #include "dis.h"
 #include "memory.h"
 
-static int checksum = 0;
+static __thread int checksum = 0;
 
 static int get_hex (FILE *f)
 {
@@ -23,7 +23,7 @@
 static void
 read_hiseg (FILE *f, struct pdp10_memory *memory, int cpu_model)
 {
-  fprintf (output_file, "Hiseg format\n");
+  fprintf (file_context->output, "Hiseg format\n");
 
   read_raw_at (f, memory, JBHGH);
   set_word_at (memory, JBSA, get_word_at (memory, JBHGH+JBHSA));
@@ -38,7 +38,7 @@ read_hiseg (FILE *f, struct pdp10_memory *memory, int cpu_model)
 static void
 write_hiseg (FILE *f, struct pdp10_memory *memory)
 {
-  set_word_at (memory, JBHSA, start_instruction & 0777777);
+  set_word_at (memory, JBHSA, file_context->start_instruction & 0777777);
   set_word_at (memory, JBHGA, (word_t)JBHGH << 9);
   write_raw_at (f, memory, JBHGH);
 }
@@ -18,7 +18,7 @@
 #include "dis.h"
 #include "memory.h"
 
-static int checksum = 0;
+static __thread int checksum = 0;
 
 /* "Special TTY" boostrap loader. */
 static char *loader =
@@ -77,7 +77,7 @@ read_iml (FILE *f, struct pdp10_memory *memory, int cpu_model)
   int i;
 
   (void)cpu_model;
-  start_instruction = 0;
+  file_context->start_instruction = 0;
 
   /* Discard block loader. */
   for (i = 0; i < 65; i++)
@@ -95,9 +95,9 @@ read_iml (FILE *f, struct pdp10_memory *memory, int cpu_model)
           address = 037714;
           while (address >= 07714)
             {
-              start_instruction = get_word_at (memory, address);
-              if (start_instruction == -1)
-                start_instruction = 0;
+              file_context->start_instruction = get_word_at (memory, address);
+              if (file_context->start_instruction == -1)
+                file_context->start_instruction = 0;
               else
                 break;
               address -= 4096;
@@ -166,7 +166,7 @@ write_iml (FILE *f, struct pdp10_memory *memory)
       out_16 (f, checksum);
     }
 
-  if (start_instruction != 0)
+  if (file_context->start_instruction != 0)
     {
       /* The special TTY loader will end up executing a jump indrected
          through 37714. */
@@ -174,7 +174,7 @@ write_iml (FILE *f, struct pdp10_memory *memory)
       out_16 (f, 037713);
       checksum = 0;
       out_16 (f, 0113714); 
-      out_16 (f, start_instruction & 037777);
+      out_16 (f, file_context->start_instruction & 037777);
       out_16 (f, checksum);
     }
 
@@ -29,7 +29,7 @@ static char loader[124] =
   "\037\357\002\032\205\000\027\362\005\000\027\364\002\051\227\360"
   "\004\040\027\370\002\033\227\360\027\370\000\044";
 
-static int checksum = 0;
+static __thread int checksum = 0;
 
 static void
 update_sum (int word)
@@ -81,7 +81,7 @@ read_imlac_pt (FILE *f, struct pdp10_memory *memory, int cpu_model)
   int c, i;
 
   (void)cpu_model;
-  start_instruction = 0;
+  file_context->start_instruction = 0;
 
   /* Discard block loader. */
   for (c = 0; c != 2;)
@@ -101,9 +101,9 @@ read_imlac_pt (FILE *f, struct pdp10_memory *memory, int cpu_model)
           address = 037714;
           while (address >= 07714)
             {
-              start_instruction = get_word_at (memory, address);
-              if (start_instruction == -1)
-                start_instruction = 0;
+              file_context->start_instruction = get_word_at (memory, address);
+              if (file_context->start_instruction == -1)
+                file_context->start_instruction = 0;
               else
                 break;
               address -= 4096;
@@ -191,14 +191,14 @@ write_imlac_pt (FILE *f, struct pdp10_memory *memory)
         }
     }
 
-  if (start_instruction != 0)
+  if (file_context->start_instruction != 0)
     {
       blank (f, 10);
       out_8 (f, 2);
       out_16 (f, 037713);
       checksum = 0;
       out_16 (f, 0113714); 
-      out_16 (f, start_instruction & 037777);
+      out_16 (f, file_context->start_instruction & 037777);
       out_16 (f, checksum);
     }
 
@@ -41,8 +41,24 @@
                      (WORD) != 0777777LL && \
                      (WORD) != 0777777777777LL)
 
-word_t start_instruction;
-FILE *output_file;
+static struct file_context default_file_context;
+
+__thread struct file_context *file_context = &default_file_context;
+
+void
+init_file_context (struct file_context *context)
+{
+  memset (context, 0, sizeof *context);
+}
+
+/* Remember an address from an entry vector, where discover_code can
+   start looking for instructions. */
+void
+add_entry_point (int address)
+{
+  if (file_context->entry_points < MAX_ENTRY_POINTS)
+    file_context->entry_point[file_context->entry_points++] = address;
+}
 
 word_t
 ascii_to_sixbit (const char *ascii)
@@ -212,7 +228,7 @@ print_date (FILE *f, word_t t)
   fprintf (f, "%u-%02u-%02u", (year >> 9) + 1900, (month >> 5), day);
 
   if ((year & 0600000) && !supress_warning)
-    fprintf (output_file, " [WARNING: overflowed year field]");
+    fprintf (file_context->output, " [WARNING: overflowed year field]");
 }
 
 void
@@ -245,27 +261,27 @@ print_symbol (word_t word1, word_t word2)
   squoze_to_ascii (word1, str);
   for (p = str; *p == ' '; p++)
     ;
-  fprintf (output_file, "    Symbol %s = ", p);
-  fprintf (output_file, "%llo   (", word2);
+  fprintf (file_context->output, "    Symbol %s = ", p);
+  fprintf (file_context->output, "%llo   (", word2);
 
   if (word1 & SYHKL)
     {
-      fprintf (output_file, " halfkilled");
+      fprintf (file_context->output, " halfkilled");
       flags |= SYMBOL_HALFKILLED;
     }
   if (word1 & SYKIL)
     {
-      fprintf (output_file, " killed");
+      fprintf (file_context->output, " killed");
       flags |= SYMBOL_KILLED;
     }
   if (word1 & SYLCL)
-    fprintf (output_file, " local");
+    fprintf (file_context->output, " local");
   if (word1 & SYGBL)
     {
-      fprintf (output_file, " global");
+      fprintf (file_context->output, " global");
       flags |= SYMBOL_GLOBAL;
     }
-  fprintf (output_file, ")\n");
+  fprintf (file_context->output, ")\n");
 
   add_symbol (p, word2, flags);
 }
@@ -277,12 +293,12 @@ sblk_info (FILE *f, word_t word0, int cpu_model)
   word_t word;
   int i;
 
-  fprintf (output_file, "Start instruction:\n");
+  fprintf (file_context->output, "Start instruction:\n");
   disassemble_word (NULL, word0, -1, cpu_model);
 
   while ((word = get_word (f)) & SIGNBIT)
     {
-      fprintf (output_file, "\n");
+      fprintf (file_context->output, "\n");
       reset_checksum (word);
       block_length = -((word >> 18) | ((-1) & ~0777777));
       switch ((int)word & 0777777)
@@ -291,7 +307,7 @@ sblk_info (FILE *f, word_t word0, int cpu_model)
 	  {
 	    char str[7];
 
-	    fprintf (output_file, "Symbol table:\n");
+	    fprintf (file_context->output, "Symbol table:\n");
 
 	    for (i = 0; i < block_length; i += 2)
 	      {
@@ -300,7 +316,8 @@ sblk_info (FILE *f, word_t word0, int cpu_model)
 		word1 = get_checksummed_word (f);
 		word2 = get_checksummed_word (f);
 		if (word1 == -1 || word2 == -1) {
-		  fprintf (output_file, "  [WARNING: early end of file]\n");
+		  fprintf (file_context->output,
+			   "  [WARNING: early end of file]\n");
 		  goto end;
 		}
 
@@ -311,34 +328,34 @@ sblk_info (FILE *f, word_t word0, int cpu_model)
 		else
 		  {
 		    squoze_to_ascii (word1, str);
-		    fprintf (output_file, "  Header: %s\n", str);
+		    fprintf (file_context->output, "  Header: %s\n", str);
 		  }
 	      }
 	    goto checksum;
 	  }
 	case STBUND:
-	  fprintf (output_file, "Undefined symbol table:\n");
+	  fprintf (file_context->output, "Undefined symbol table:\n");
 	  break;
 	case STBFIL:
 	  {
 	    char str[7];
 
-	    fprintf (output_file, "Indirect symbol table pointer:\n");
+	    fprintf (file_context->output, "Indirect symbol table pointer:\n");
 
 	    if (block_length != 4)
 	      {
-		fprintf (output_file, "  (unknown table format)\n");
+		fprintf (file_context->output, "  (unknown table format)\n");
 		break;
 	      }
 
 	    sixbit_to_ascii (get_checksummed_word (f), str);
-	    fprintf (output_file, "  Device name: %s\n", str);
+	    fprintf (file_context->output, "  Device name: %s\n", str);
 	    sixbit_to_ascii (get_checksummed_word (f), str);
-	    fprintf (output_file, "  File name 1: %s\n", str);
+	    fprintf (file_context->output, "  File name 1: %s\n", str);
 	    sixbit_to_ascii (get_checksummed_word (f), str);
-	    fprintf (output_file, "  File name 2: %s\n", str);
+	    fprintf (file_context->output, "  File name 2: %s\n", str);
 	    sixbit_to_ascii (get_checksummed_word (f), str);
-	    fprintf (output_file, "  File sname:  %s\n", str);
+	    fprintf (file_context->output, "  File sname:  %s\n", str);
 	    goto checksum;
 	  }
 	case STBINF:
@@ -351,34 +368,41 @@ sblk_info (FILE *f, word_t word0, int cpu_model)
 	    switch ((int)word & 0777777)
 	      {
 	      case 1:
-		fprintf (output_file, "Assembly info:\n");
+		fprintf (file_context->output, "Assembly info:\n");
 		sixbit_to_ascii (get_checksummed_word (f), str);
-		fprintf (output_file, "  User name:          %s\n", str);
-		fprintf (output_file, "  Creation time:      ");
-		print_datime (output_file, get_checksummed_word (f));
-		fputc ('\n', output_file);
+		fprintf (file_context->output,
+			 "  User name:          %s\n", str);
+		fprintf (file_context->output, "  Creation time:      ");
+		print_datime (file_context->output, get_checksummed_word (f));
+		fputc ('\n', file_context->output);
 		sixbit_to_ascii (get_checksummed_word (f), str);
-		fprintf (output_file, "  Source file device: %s\n", str);
+		fprintf (file_context->output,
+			 "  Source file device: %s\n", str);
 		sixbit_to_ascii (get_checksummed_word (f), str);
-		fprintf (output_file, "  Source file name 1: %s\n", str);
+		fprintf (file_context->output,
+			 "  Source file name 1: %s\n", str);
 		sixbit_to_ascii (get_checksummed_word (f), str);
-		fprintf (output_file, "  Source file name 2: %s\n", str);
+		fprintf (file_context->output,
+			 "  Source file name 2: %s\n", str);
 		sixbit_to_ascii (get_checksummed_word (f), str);
-		fprintf (output_file, "  Source file sname:  %s\n", str);
+		fprintf (file_context->output,
+			 "  Source file sname:  %s\n", str);
 		for (i = 0; i < block_length - subblock_length - 1; i++)
 		  {
-		    fprintf (output_file, "  (%012llo)\n", get_checksummed_word(f));
+		    fprintf (file_context->output, "  (%012llo)\n", get_checksummed_word(f));
 		  }
 		goto checksum;
 	      case 2:
-		fprintf (output_file, "Debugging info:\n");
+		fprintf (file_context->output, "Debugging info:\n");
 		break;
 	      default:
-		fprintf (output_file, "Unknown miscellaneous info:\n");
+		fprintf (file_context->output,
+			 "Unknown miscellaneous info:\n");
 		break;
 	      }
 
-	    fprintf (output_file, "    (%d words)\n", subblock_length);
+	    fprintf (file_context->output,
+		     "    (%d words)\n", subblock_length);
 	    for (i = 0; i < subblock_length; i++)
 	      {
 		get_checksummed_word (f);
@@ -387,11 +411,11 @@ sblk_info (FILE *f, word_t word0, int cpu_model)
 	    goto checksum;
 	  }
 	default:
-	  fprintf (output_file, "Unknown information:\n");
+	  fprintf (file_context->output, "Unknown information:\n");
 	  break;
 	}
 
-      fprintf (output_file, "(%d words)\n", block_length);
+      fprintf (file_context->output, "(%d words)\n", block_length);
       for (i = 0; i < block_length; i++)
 	{
 	  get_checksummed_word (f);
@@ -404,7 +428,7 @@ sblk_info (FILE *f, word_t word0, int cpu_model)
       check_checksum (word);
     }
 
-  fprintf (output_file, "\nDuplicate start instruction:\n");
+  fprintf (file_context->output, "\nDuplicate start instruction:\n");
   disassemble_word (NULL, word, -1, cpu_model);
 
  end:
@@ -433,17 +457,17 @@ print_sail_symbol (word_t word, word_t block, word_t value)
     {
     case 000: /* Program name. */
       if (*str != 0)
-	fprintf (output_file, "  Program: %s\n", str);
+	fprintf (file_context->output, "  Program: %s\n", str);
       break;
     case 003: /* Block name. */
-      fprintf (output_file, "  Block: %s\n", str);
+      fprintf (file_context->output, "  Block: %s\n", str);
       break;
     default:
-      fprintf (output_file, "    Symbol %s ", str);
+      fprintf (file_context->output, "    Symbol %s ", str);
       squoze_to_ascii (block, str2);
       if (block != 0)
-	fprintf (output_file, "[%s] ", unpad (str2));
-      fprintf (output_file, "= %llo (%02o)\n", value, flags);
+	fprintf (file_context->output, "[%s] ", unpad (str2));
+      fprintf (file_context->output, "= %llo (%02o)\n", value, flags);
       add_symbol (str, value, 0); /* Don't know what flags mean. */
     }
 }
@@ -462,7 +486,7 @@ dmp_new_symbols (struct pdp10_memory *memory, int table)
   class4 = get_word_at (memory, table + 8);
   lastv = get_word_at (memory, table + 9);
 
-  fprintf (output_file, "\nSymbol table:\n");
+  fprintf (file_context->output, "\nSymbol table:\n");
 
   for (i = class1; i < class2; i += 2)
     {
@@ -505,12 +529,14 @@ dmp_info (struct pdp10_memory *memory, int cpu_model)
 
   /* For the PDP-6 monitor, JBSA is the start address. */
   jbsa = get_word_at (memory, 0120);
-  fprintf (output_file, "Start address (PDP-6): %06llo\n", jbsa & 0777777);
-  start_instruction = JRST + (jbsa & 0777777);
+  fprintf (file_context->output,
+	   "Start address (PDP-6): %06llo\n", jbsa & 0777777);
+  file_context->start_instruction = JRST + (jbsa & 0777777);
 
   /* For WAITS, JBDA is a JRST to the start address. */
   jbda = get_word_at (memory, 0140);
-  fprintf (output_file, "Start address (WAITS): %06llo\n", jbda & 0777777);
+  fprintf (file_context->output,
+	   "Start address (WAITS): %06llo\n", jbda & 0777777);
 
   /* .JBSYM is an AOBJN pointer to DDT's symbol table.  If the
      executable doesn't have one, it may be an pointer past the end of
@@ -527,7 +553,7 @@ dmp_info (struct pdp10_memory *memory, int cpu_model)
       int i;
       int length = 01000000 - (jbsym >> 18);
 
-      fprintf (output_file, "\nSymbol table:\n");
+      fprintf (file_context->output, "\nSymbol table:\n");
 
       for (i = length - 2; i >= 0; i -= 2)
 	{
@@ -541,7 +567,7 @@ dmp_info (struct pdp10_memory *memory, int cpu_model)
 void
 dec_symbols (struct pdp10_memory *memory, int address, int length)
 {
-  fprintf (output_file, "Symbol table:\n");
+  fprintf (file_context->output, "Symbol table:\n");
 
   while (length > 0)
     {
@@ -564,17 +590,17 @@ dec_info (struct pdp10_memory *memory,
     {
       word = get_word_at (memory, JBREL);
       if (word != -1 && (word & 0777777) != 0)
-	fprintf (output_file, "Highest lowseg location: %llo\n",
+	fprintf (file_context->output, "Highest lowseg location: %llo\n",
 		 word & 0777777);
 
       word = get_word_at (memory, JBREL);
       if (GOOD (word))
-	fprintf (output_file, "DDT from %llo to %llo\n",
+	fprintf (file_context->output, "DDT from %llo to %llo\n",
 		 word & 0777777, (word >> 18) & 0777777);
 
       word = get_word_at (memory, JBHRL);
       if (word != -1 && (word & 0777777) != 0)
-	fprintf (output_file, "Highest hiseg location: %llo\n",
+	fprintf (file_context->output, "Highest hiseg location: %llo\n",
 		 word & 0777777);
 
       if (entry_vec_addr != 0)
@@ -584,47 +610,55 @@ dec_info (struct pdp10_memory *memory,
       if (GOOD (word))
 	{
 	  word &= 0777777;
-	  fprintf (output_file, "Start address: %06llo\n", word);
-	  start_instruction = JRST + word;
+	  fprintf (file_context->output, "Start address: %06llo\n", word);
+	  file_context->start_instruction = JRST + word;
 	}
 
       word = get_word_at (memory, JBREN);
       if (GOOD (word))
-	fprintf (output_file, "Reentry address: %06llo\n", word & 0777777);
+	{
+	  fprintf (file_context->output,
+		   "Reentry address: %06llo\n", word & 0777777);
+	  add_entry_point (word & 0777777);
+	}
 
       word = get_word_at (memory, JBVER);
       if (GOOD (word))
-	fprintf (output_file, "Version: %012llo\n", word);
+	fprintf (file_context->output, "Version: %012llo\n", word);
     }
   else
     {
-      fprintf (output_file, "Entry vector at %06llo length %llo:\n",
+      fprintf (file_context->output, "Entry vector at %06llo length %llo:\n",
 	      entry_vec_addr, entry_vec_len);
 
       if (entry_vec_len == 1)
 	{
-	  fprintf (output_file, "Start address: %06llo\n", entry_vec_addr);
+	  fprintf (file_context->output,
+		   "Start address: %06llo\n", entry_vec_addr);
+	  add_entry_point (entry_vec_addr);
 	}
       else if (entry_vec_len == 3)
 	{
 	  int addr;
 
-	  fprintf (output_file, "Start instruction:\n");
+	  fprintf (file_context->output, "Start instruction:\n");
 	  addr = entry_vec_addr;
 	  disassemble_word (memory, get_word_at (memory, addr),
 			    addr, cpu_model);
+	  add_entry_point (addr);
 
 	  word = get_word_at (memory, ++addr);
 	  if (GOOD (word))
 	    {
-	      fprintf (output_file, "Reentry instruction:\n");
+	      fprintf (file_context->output, "Reentry instruction:\n");
 	      disassemble_word (memory, word, addr, cpu_model);
+	      add_entry_point (addr);
 	    }
 
 	  word = get_word_at (memory, ++addr);
 	  if (GOOD (word))
 	    {
-	      fprintf (output_file, "Version: %012llo\n", word);
+	      fprintf (file_context->output, "Version: %012llo\n", word);
 	    }
 	}
     }
@@ -683,7 +717,7 @@ ntsddt_info (struct pdp10_memory *memory, int ddt)
   syms = -syms;
   a &= 0777777;
 
-  fprintf (output_file, "Symbol table:\n");
+  fprintf (file_context->output, "Symbol table:\n");
 
   for (i = 0; i < syms; i += 2)
     {
@@ -694,7 +728,7 @@ ntsddt_info (struct pdp10_memory *memory, int ddt)
       else
 	{
 	  squoze_to_ascii (w, name);
-	  fprintf (output_file, "  Header: %s (%012llo)\n", name, v);
+	  fprintf (file_context->output, "  Header: %s (%012llo)\n", name, v);
 	}
       a += 2;
     }
@@ -87,14 +87,12 @@ main (int argc, char **argv)
   int ipak_size;
   int extract;
   char string[7];
-  word_t word;
-  word_t *p;
   word_t key = 0;
   FILE *f;
   int opt;
   int i;
 
-  output_file = stdout;
+  file_context->output = stdout;
 
   while ((opt = getopt (argc, argv, "etxW:X:")) != -1)
     {
@@ -127,15 +125,9 @@ main (int argc, char **argv)
 
   f = fopen (argv[optind], "rb");
 
-  p = buffer;
-  while ((word = get_word (f)) != -1)
-    {
-      *p++ = word;
-    }
+  ipak_size = get_words (f, buffer, sizeof buffer / sizeof buffer[0]);
   fclose (f);
 
-  ipak_size = p - buffer;
-
   if (buffer[0] == MAGIC)
     {
       fprintf (stderr, "Format: 1977\n");
@@ -173,13 +173,11 @@ main (int argc, char **argv)
 {
   int extract;
   char string[7];
-  word_t word;
-  word_t *p;
   FILE *f;
 
-  input_word_format = &its_word_format;
-  output_word_format = &its_word_format;
-  output_file = stdout;
+  word_context->input_format = &its_word_format;
+  word_context->output_format = &its_word_format;
+  file_context->output = stdout;
 
   if (argc != 3)
     usage (argv[0]);
@@ -202,15 +200,9 @@ main (int argc, char **argv)
 
   f = fopen (argv[2], "rb");
 
-  p = buffer;
-  while ((word = get_word (f)) != -1)
-    {
-      *p++ = word;
-    }
+  get_words (f, buffer, sizeof buffer / sizeof buffer[0]);
   fclose (f);
 
-  /* word_t arc_size = p - buffer; */
-
   if (buffer[0] == NEW_ARC)
     {
       /* fprintf (stderr, "New ARC1!! archive.\n") */ ;
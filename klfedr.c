@@ -59,8 +59,8 @@ main (int argc, char **argv)
   (void)argc;
   (void)argv;
 
-  input_word_format = &its_word_format;
-  output_word_format = &its_word_format;
+  word_context->input_format = &its_word_format;
+  word_context->output_format = &its_word_format;
 
   /* The KLDCP direcory is 64 sectors. */
   for (i = 0; i < 64; i++)
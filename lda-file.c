@@ -18,7 +18,7 @@
 #include "dis.h"
 #include "memory.h"
 
-int checksum;
+static __thread int checksum;
 
 static int
 get_8 (FILE *f)
@@ -47,7 +47,7 @@ read_lda (FILE *f, struct pdp10_memory *memory, int cpu_model)
   word_t *core;
 
   (void)cpu_model;
-  start_instruction = 1;
+  file_context->start_instruction = 1;
 
   for (;;)
     {
@@ -70,7 +70,7 @@ read_lda (FILE *f, struct pdp10_memory *memory, int cpu_model)
       if (length == 0)
         {
           if ((address & 1) == 0)
-            start_instruction = address;
+            file_context->start_instruction = address;
           return;
         }
 
@@ -128,7 +128,8 @@ write_lda (FILE *f, struct pdp10_memory *memory)
 
   out_16 (f, 1);
   out_16 (f, length + 6);
-  out_16 (f, start_instruction & 1 ? 0 : start_instruction);
+  start = file_context->start_instruction;
+  out_16 (f, start & 1 ? 0 : start);
 }
 
 struct file_format lda_file_format = {
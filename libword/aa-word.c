@@ -28,12 +28,10 @@
 
 #include "libword.h"
 
-static word_t output = -1;
-
 static inline int
 get_byte (FILE *f)
 {
-  int c = fgetc (f);
+  int c = get_octet (f);
   return c == EOF ? 0 : c;
 }
 
@@ -43,11 +41,11 @@ get_aa_word (FILE *f)
   word_t word = 0;
   word_t x;
 
-  if (feof (f))
+  if (eof_octet (f))
     return -1;
 
   x = get_byte (f); word += (x & 0177) << 29;
-  if (feof (f))
+  if (eof_octet (f))
     return -1;
   x = get_byte (f); word += (x & 0177) << 22;
   x = get_byte (f); word += (x & 0177) << 15;
@@ -61,44 +59,47 @@ get_aa_word (FILE *f)
 static void
 write_aa_word (FILE *f, word_t word)
 {
-  if (output != -1)
+  struct word_context *c = word_context;
+
+  if (c->aa.output != -1)
     {
-      fputc ((output >> 29) & 0177, f);
-      fputc ((output >> 22) & 0177, f);
-      fputc ((output >> 15) & 0177, f);
-      fputc ((output >>  8) & 0177, f);
-      fputc (((output >> 1) & 0177) +
-	     ((output << 7) & 0200), f);
+      putc_unlocked ((c->aa.output >> 29) & 0177, f);
+      putc_unlocked ((c->aa.output >> 22) & 0177, f);
+      putc_unlocked ((c->aa.output >> 15) & 0177, f);
+      putc_unlocked ((c->aa.output >>  8) & 0177, f);
+      putc_unlocked (((c->aa.output >> 1) & 0177) +
+		     ((c->aa.output << 7) & 0200), f);
     }
 
-  output = word;
+  c->aa.output = word;
 }
 
 static void
 flush_aa_word (FILE *f)
 {
   int i, c;
-  if (output == -1)
+  if (word_context->aa.output == -1)
     return;
-  fputc ((output >> 29) & 0177, f);
+  putc_unlocked ((word_context->aa.output >> 29) & 0177, f);
   for (i = 0; i < 4; i++)
     {
-      output &= 03777777777LL;
-      if (output == 0)
+      word_context->aa.output &= 03777777777LL;
+      if (word_context->aa.output == 0)
 	break;
-      c = (output >> 22) & 0177;
-      if (i == 3 && (output & 010000000LL) != 0)
+      c = (word_context->aa.output >> 22) & 0177;
+      if (i == 3 && (word_context->aa.output & 010000000LL) != 0)
 	c |= 0200;
-      fputc (c, f);
-      output <<= 7;
+      putc_unlocked (c, f);
+      word_context->aa.output <<= 7;
     }
-  output = -1;
+  word_context->aa.output = -1;
 }
 
 struct word_format aa_word_format = {
   "ascii",
   get_aa_word,
   NULL,
+  NULL,
   by_five_octets,
   write_aa_word,
   flush_aa_word
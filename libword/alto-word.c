@@ -20,7 +20,7 @@
 static int
 get_byte (FILE *f)
 {
-  int c = fgetc (f);
+  int c = get_octet (f);
   return c == EOF ? 0 : c;
 }
 
@@ -30,11 +30,11 @@ get_alto_word (FILE *f)
   word_t x1, x2, x3, x4, x5;
   word_t word;
 
-  if (feof (f))
+  if (eof_octet (f))
     return -1;
 
   x1 = get_byte (f);
-  if (feof (f))
+  if (eof_octet (f))
     return -1;
   x2 = get_byte (f);
   x3 = get_byte (f);
@@ -49,17 +49,18 @@ get_alto_word (FILE *f)
 void
 write_alto_word (FILE *f, word_t word)
 {
-  fputc ((word >> 32) & 0x0F, f);
-  fputc ((word >> 24) & 0xFF, f);
-  fputc ((word >> 16) & 0xFF, f);
-  fputc ((word >>  8) & 0xFF, f);
-  fputc ( word        & 0xFF, f);
+  putc_unlocked ((word >> 32) & 0x0F, f);
+  putc_unlocked ((word >> 24) & 0xFF, f);
+  putc_unlocked ((word >> 16) & 0xFF, f);
+  putc_unlocked ((word >>  8) & 0xFF, f);
+  putc_unlocked ( word        & 0xFF, f);
 }
 
 struct word_format alto_word_format = {
   "alto",
   get_alto_word,
   NULL,
+  NULL,
   by_five_octets,
   write_alto_word,
   NULL
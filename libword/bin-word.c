@@ -20,46 +20,58 @@
 #define WORDMASK	(0777777777777LL)
 #define SIGNBIT		(0400000000000LL)
 
-static int leftover_input, have_leftover_input = 0;
-static int leftover_output, have_leftover_output = 0;
-
 static inline int
 get_byte (FILE *f)
 {
-  int c = fgetc (f);
+  int c = get_octet (f);
   return c == EOF ? 0 : c;
 }
 
 static word_t
 get_bin_word (FILE *f)
 {
+  struct word_context *c = word_context;
+  const unsigned char *p;
   unsigned char byte;
   word_t word;
 
-  if (feof (f))
+  if (eof_octet (f))
     return -1;
 
-  if (have_leftover_input)
+  if (c->bin.have_leftover_input && (p = get_octets (f, 4)) != NULL)
+    {
+      word = (word_t)c->bin.leftover_input << 32 | (word_t)p[0] << 24 |
+             (word_t)p[1] << 16 | (word_t)p[2] << 8 | (word_t)p[3];
+      c->bin.have_leftover_input = 0;
+    }
+  else if (!c->bin.have_leftover_input && (p = get_octets (f, 5)) != NULL)
+    {
+      word = (word_t)p[0] << 28 | (word_t)p[1] << 20 |
+             (word_t)p[2] << 12 | (word_t)p[3] << 4 | (word_t)p[4] >> 4;
+      c->bin.have_leftover_input = 1;
+      c->bin.leftover_input = p[4] & 0x0f;
+    }
+  else if (c->bin.have_leftover_input)
     {
-      word = (word_t)leftover_input << 32 |
+      word = (word_t)c->bin.leftover_input << 32 |
 	     (word_t)get_byte (f) << 24 |
 	     (word_t)get_byte (f) << 16 |
              (word_t)get_byte (f) <<  8 |
              (word_t)get_byte (f) <<  0;
-      have_leftover_input = 0;
+      c->bin.have_leftover_input = 0;
     }
   else
     {
       word =  ((word_t)get_byte (f) << 28);
-      if (feof (f))
+      if (eof_octet (f))
 	return -1;
       word |= ((word_t)get_byte (f) << 20) |
 	      ((word_t)get_byte (f) << 12) |
               ((word_t)get_byte (f) <<  4);
       byte = get_byte (f);
       word |=  (word_t)byte >> 4;
-      have_leftover_input = 1;
-      leftover_input = byte & 0x0f;
+      c->bin.have_leftover_input = 1;
+      c->bin.leftover_input = byte & 0x0f;
     }
 
   if (word > WORDMASK)
@@ -71,61 +83,101 @@ get_bin_word (FILE *f)
   return word;
 }
 
+static size_t
+get_bin_words (FILE *f, word_t *buffer, size_t n)
+{
+  unsigned char octets[9 * 64];
+  const unsigned char *p;
+  size_t i, k;
+
+  /* Get to an octet boundary. */
+  i = 0;
+  if (word_context->bin.have_leftover_input && n > 0)
+    {
+      if ((buffer[i++] = get_bin_word (f)) == -1)
+        return 0;
+    }
+
+  /* Two words are stored in nine octets. */
+  for (; n - i >= 2; i += 2 * k)
+    {
+      k = (n - i) / 2 > 64 ? 64 : (n - i) / 2;
+      p = get_octet_block (f, octets, 9 * k);
+      if (p == NULL)
+        break;
+      unpack_bin (p, buffer + i, k);
+    }
+
+  /* Go word by word for the rest. */
+  for (; i < n; i++)
+    {
+      if ((buffer[i] = get_bin_word (f)) == -1)
+        break;
+    }
+
+  return i;
+}
+
 static void
 rewind_bin_word (FILE *f)
 {
-  have_leftover_input = 0;
-  rewind (f);
+  word_context->bin.have_leftover_input = 0;
+  rewind_octet (f);
 }
 
 static void
 seek_bin_word (FILE *f, int position)
 {
   rewind_bin_word (f);
-  fseek (f, 9 * position / 2, SEEK_SET);
+  seek_octet (f, 9L * position / 2);
   if (position & 1)
     {
-      leftover_input = get_byte (f) & 0x0f;
-      have_leftover_input = 1;
+      word_context->bin.leftover_input = get_byte (f) & 0x0f;
+      word_context->bin.have_leftover_input = 1;
     }
 }
 
 static void
 write_bin_word (FILE *f, word_t word)
 {
-  if (have_leftover_output)
+  struct word_context *c = word_context;
+
+  if (c->bin.have_leftover_output)
     {
-      fputc (leftover_output | ((word >> 32) & 0x0f), f);
-      fputc ((word >> 24) & 0xff, f);
-      fputc ((word >> 16) & 0xff, f);
-      fputc ((word >>  8) & 0xff, f);
-      fputc ((word >>  0) & 0xff, f);
-      have_leftover_output = 0;
+      putc_unlocked (c->bin.leftover_output | ((word >> 32) & 0x0f), f);
+      putc_unlocked ((word >> 24) & 0xff, f);
+      putc_unlocked ((word >> 16) & 0xff, f);
+      putc_unlocked ((word >>  8) & 0xff, f);
+      putc_unlocked ((word >>  0) & 0xff, f);
+      c->bin.have_leftover_output = 0;
     }
   else
     {
-      fputc ((word >> 28) & 0xff, f);
-      fputc ((word >> 20) & 0xff, f);
-      fputc ((word >> 12) & 0xff, f);
-      fputc ((word >>  4) & 0xff, f);
-      have_leftover_output = 1;
-      leftover_output = (word << 4) & 0xf0;
+      putc_unlocked ((word >> 28) & 0xff, f);
+      putc_unlocked ((word >> 20) & 0xff, f);
+      putc_unlocked ((word >> 12) & 0xff, f);
+      putc_unlocked ((word >>  4) & 0xff, f);
+      c->bin.have_leftover_output = 1;
+      c->bin.leftover_output = (word << 4) & 0xf0;
     }
 }
 
 static void
 flush_bin_word (FILE *f)
 {
-  if (have_leftover_output)
+  struct word_context *c = word_context;
+
+  if (c->bin.have_leftover_output)
     {
-      fputc (leftover_output, f);
-      have_leftover_output = 0;
+      putc_unlocked (c->bin.leftover_output, f);
+      c->bin.have_leftover_output = 0;
     }
 }
 
 struct word_format bin_word_format = {
   "bin",
   get_bin_word,
+  get_bin_words,
   rewind_bin_word,
   seek_bin_word,
   write_bin_word,
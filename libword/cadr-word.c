@@ -26,10 +26,10 @@
 static void
 write_cadr_word (FILE *f, word_t word)
 {
-  fputc ((word >> 20) & 0377, f);
-  fputc ((word >> 28) & 0377, f);
-  fputc ((word >>  4) & 0377, f);
-  fputc ((word >> 12) & 0377, f);
+  putc_unlocked ((word >> 20) & 0377, f);
+  putc_unlocked ((word >> 28) & 0377, f);
+  putc_unlocked ((word >>  4) & 0377, f);
+  putc_unlocked ((word >> 12) & 0377, f);
 }
 
 struct word_format cadr_word_format = {
@@ -37,6 +37,7 @@ struct word_format cadr_word_format = {
   NULL,
   NULL,
   NULL,
+  NULL,
   write_cadr_word,
   NULL
 };
@@ -20,18 +20,24 @@
 static int
 get_byte (FILE *f)
 {
-  int c = fgetc (f);
+  int c = get_octet (f);
   return c == EOF ? 0 : c;
 }
 
 word_t
 get_core_word (FILE *f)
 {
+  const unsigned char *p;
   word_t word;
 
-  if (feof (f))
+  if (eof_octet (f))
     return -1;
 
+  p = get_octets (f, 5);
+  if (p != NULL)
+    return ((word_t)p[0] << 28) | ((word_t)p[1] << 20) |
+           ((word_t)p[2] << 12) | ((word_t)p[3] <<  4) | (word_t)p[4];
+
   word = ((word_t)get_byte (f) << 28) |
          ((word_t)get_byte (f) << 20) |
          ((word_t)get_byte (f) << 12) |
@@ -41,19 +47,46 @@ get_core_word (FILE *f)
   return word;
 }
 
+static size_t
+get_core_words (FILE *f, word_t *buffer, size_t n)
+{
+  unsigned char octets[5 * 128];
+  const unsigned char *p;
+  size_t i, k;
+
+  for (i = 0; i < n; i += k)
+    {
+      k = n - i > 128 ? 128 : n - i;
+      p = get_octet_block (f, octets, 5 * k);
+      if (p == NULL)
+        break;
+      unpack_core (p, buffer + i, k);
+    }
+
+  /* Less than a full block left, go word by word. */
+  for (; i < n; i++)
+    {
+      if ((buffer[i] = get_core_word (f)) == -1)
+        break;
+    }
+
+  return i;
+}
+
 void
 write_core_word (FILE *f, word_t word)
 {
-  fputc ((word >> 28) & 0xFF, f);
-  fputc ((word >> 20) & 0xFF, f);
-  fputc ((word >> 12) & 0xFF, f);
-  fputc ((word >>  4) & 0xFF, f);
-  fputc ( word        & 0x0F, f);
+  putc_unlocked ((word >> 28) & 0xFF, f);
+  putc_unlocked ((word >> 20) & 0xFF, f);
+  putc_unlocked ((word >> 12) & 0xFF, f);
+  putc_unlocked ((word >>  4) & 0xFF, f);
+  putc_unlocked ( word        & 0x0F, f);
 }
 
 struct word_format core_word_format = {
   "core",
   get_core_word,
+  get_core_words,
   NULL,
   by_five_octets,
   write_core_word,
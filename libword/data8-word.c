@@ -26,7 +26,7 @@ get_data8_word (FILE *f)
 
   for (i = 0; i < 64; i += 8)
     {
-      c = fgetc (f);
+      c = get_octet (f);
       if (c == EOF)
         return -1;
       word |= (word_t)(c & 0xff) << i;
@@ -41,20 +41,21 @@ get_data8_word (FILE *f)
 static void
 write_data8_word (FILE *f, word_t word)
 {
-  fputc ((word >>  0) & 0xff, f);
-  fputc ((word >>  8) & 0xff, f);
-  fputc ((word >> 16) & 0xff, f);
-  fputc ((word >> 24) & 0xff, f);
-  fputc ((word >> 32) & 0xff, f);
-  fputc (0, f);
-  fputc (0, f);
-  fputc (0, f);
+  putc_unlocked ((word >>  0) & 0xff, f);
+  putc_unlocked ((word >>  8) & 0xff, f);
+  putc_unlocked ((word >> 16) & 0xff, f);
+  putc_unlocked ((word >> 24) & 0xff, f);
+  putc_unlocked ((word >> 32) & 0xff, f);
+  putc_unlocked (0, f);
+  putc_unlocked (0, f);
+  putc_unlocked (0, f);
 }
 
 struct word_format data8_word_format = {
   "data8",
   get_data8_word,
   NULL,
+  NULL,
   by_eight_octets,
   write_data8_word,
   NULL
@@ -17,19 +17,17 @@
 
 #include "libword.h"
 
-static int position = 0;
-
 static void
 rewind_dta_word (FILE *f)
 {
-  position = 0;
-  rewind (f);
+  word_context->dta.position = 0;
+  rewind_octet (f);
 }
 
 static inline int
 get_byte (FILE *f)
 {
-  int c = fgetc (f);
+  int c = get_octet (f);
   return c == EOF ? 0 : c;
 }
 
@@ -45,28 +43,80 @@ get_half (FILE *f)
 static word_t
 get_dta_word (FILE *f)
 {
+  const unsigned char *p;
   word_t word;
 
-  if (feof (f))
+  if (eof_octet (f))
     return -1;
 
-  word = (get_half (f) << 18);
-  word += get_half (f);
-
-  if ((position % 128) == 0)
+  p = get_octets (f, 8);
+  if (p != NULL)
+    {
+      word = (word_t)(p[0] + (p[1] << 8) + (p[2] << 16) + (p[3] << 24)) << 18;
+      word += p[4] + (p[5] << 8) + (p[6] << 16) + (p[7] << 24);
+    }
+  else
+    {
+      word = (get_half (f) << 18);
+      word += get_half (f);
+    }
+
+  if ((word_context->dta.position % 128) == 0)
     word |= START_RECORD;
 
-  position++;
+  word_context->dta.position++;
   return word;
 }
 
+static size_t
+get_dta_words (FILE *f, word_t *buffer, size_t n)
+{
+  unsigned char octets[8 * 128];
+  const unsigned char *p;
+  size_t i, j, k;
+  word_t word;
+
+  for (i = 0; i < n; i += k)
+    {
+      k = n - i > 128 ? 128 : n - i;
+      p = get_octet_block (f, octets, 8 * k);
+      if (p == NULL)
+        break;
+      unpack_dta (p, buffer + i, k);
+      for (j = 0; j < k; j++)
+        {
+          word = buffer[i + j];
+          if ((word_context->dta.position % 128) == 0)
+            word |= START_RECORD;
+          word_context->dta.position++;
+          buffer[i + j] = word;
+
+          /* Stop at a word which looks like the end of input. */
+          if (word == -1)
+            {
+              unget_octet_block (f, 8 * (k - j - 1));
+              return i + j;
+            }
+        }
+    }
+
+  /* Less than a full block left, go word by word. */
+  for (; i < n; i++)
+    {
+      if ((buffer[i] = get_dta_word (f)) == -1)
+        break;
+    }
+
+  return i;
+}
+
 static void
 write_half (FILE *f, int word)
 {
-  fputc (word & 0377, f);
-  fputc ((word >> 8) & 0377, f);
-  fputc ((word >> 16) & 0377, f);
-  fputc ((word >> 24) & 0377, f);
+  putc_unlocked (word & 0377, f);
+  putc_unlocked ((word >> 8) & 0377, f);
+  putc_unlocked ((word >> 16) & 0377, f);
+  putc_unlocked ((word >> 24) & 0377, f);
 }
 
 void
@@ -79,6 +129,7 @@ write_dta_word (FILE *f, word_t word)
 struct word_format dta_word_format = {
   "dta",
   get_dta_word,
+  get_dta_words,
   rewind_dta_word,
   by_eight_octets,
   write_dta_word,
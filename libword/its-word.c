@@ -15,245 +15,337 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <pthread.h>
 #include "libword.h"
 
-static int leftover, there_is_some_leftover = 0;
-static word_t output = -1;
-
 static void write_its_word (FILE *f, word_t word);
 
 #define WORDMASK	(0777777777777LL)
 #define SIGNBIT		(0400000000000LL)
 
+/* Octets in a block for get_its_words.  A word never takes more than
+   five octets. */
+#define BLOCK		4096
+#define WORD_OCTETS	5
+
+/* Each octet in the file stands for one or two 7-bit characters, or
+   starts a binary word if the count is zero. */
+struct decode
+{
+  unsigned char n;
+  unsigned char c[2];
+};
+
+/* Characters following a CR or a rubout are encoded specially.  Each
+   character in each of those states turns into up to two octets, and
+   a new state. */
+enum { PLAIN, CR, RUBOUT, STATES };
+
+struct encode
+{
+  unsigned char n;
+  unsigned char state;
+  unsigned char octet[2];
+};
+
+static struct decode decode[256];
+static struct encode encode[STATES][128];
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
+
+static void
+set_decode (int octet, int n, int c0, int c1)
+{
+  decode[octet].n = n;
+  decode[octet].c[0] = c0;
+  decode[octet].c[1] = c1;
+}
+
+static void
+set_encode (int state, int c, int new_state, int n, int o0, int o1)
+{
+  encode[state][c].n = n;
+  encode[state][c].state = new_state;
+  encode[state][c].octet[0] = o0;
+  encode[state][c].octet[1] = o1;
+}
+
+static void
+init_tables (void)
+{
+  int i;
+
+  for (i = 0; i <= 0176; i++)
+    set_decode (i, 1, i, 0);
+  set_decode (012, 2, 015, 012);
+  set_decode (015, 1, 012, 0);
+  set_decode (0177, 2, 0177, 7);
+  for (i = 0200; i <= 0355; i++)
+    set_decode (i, 2, 0177, i - 0200);
+  set_decode (0207, 2, 0177, 0177);
+  set_decode (0212, 2, 0177, 015);
+  set_decode (0215, 2, 0177, 012);
+  set_decode (0356, 1, 015, 0);
+  set_decode (0357, 1, 0177, 0);
+  for (i = 0360; i <= 0377; i++)
+    set_decode (i, 0, 0, 0);
+
+  for (i = 0; i < 128; i++)
+    {
+      set_encode (PLAIN, i, PLAIN, 1, i, 0);
+      set_encode (CR, i, PLAIN, 2, 0356, i);
+      if (i < 0156)
+	set_encode (RUBOUT, i, PLAIN, 1, i + 0200, 0);
+      else
+	set_encode (RUBOUT, i, PLAIN, 2, 0357, i);
+    }
+  set_encode (PLAIN, 012, PLAIN, 1, 015, 0);
+  set_encode (PLAIN, 015, CR, 0, 0, 0);
+  set_encode (PLAIN, 0177, RUBOUT, 0, 0, 0);
+  set_encode (CR, 012, PLAIN, 1, 012, 0);
+  set_encode (CR, 015, PLAIN, 2, 0356, 0356);
+  set_encode (CR, 0177, PLAIN, 2, 0356, 0357);
+  set_encode (RUBOUT, 0007, PLAIN, 1, 0177, 0);
+  set_encode (RUBOUT, 0012, PLAIN, 1, 0215, 0);
+  set_encode (RUBOUT, 0015, PLAIN, 1, 0212, 0);
+  set_encode (RUBOUT, 0177, PLAIN, 1, 0207, 0);
+}
+
+static inline void
+tables (void)
+{
+  pthread_once (&tables_once, init_tables);
+}
+
 static inline int
 get_byte (FILE *f)
 {
-  int c = fgetc (f);
+  int c = get_octet (f);
   return c == EOF ? 0 : c;
 }
 
-static inline word_t
-insert (word_t word, unsigned char byte, int *bits)
+static void
+format_error (void)
 {
-  *bits += 7;
-  return (word << 7) | byte;
+  fprintf (stderr, "[error in 36-bit file format]\n");
+  exit (1);
 }
 
 static word_t
 get_its_word (FILE *f)
 {
-  unsigned char byte;
+  const struct decode *d;
   word_t word;
   int bits;
 
-  if (feof (f))
+  tables ();
+
+  if (eof_octet (f))
     return -1;
 
   word = 0;
   bits = 0;
 
-  if (there_is_some_leftover)
+  if (word_context->its.have_leftover)
     {
-      word = leftover;
+      word = word_context->its.leftover;
       bits = 7;
-      there_is_some_leftover = 0;
+      word_context->its.have_leftover = 0;
     }
 
-  while (bits < 36)
+  while (bits < 35)
     {
-      byte = get_byte (f);
-      if (feof (f))
-	{
-	  if (bits == 0)
-	    return -1;
-	}
+      d = &decode[get_byte (f)];
+      if (eof_octet (f) && bits == 0)
+	return -1;
 
-      if (byte <= 011 ||
-	  (byte >= 013 && byte <= 014) ||
-	  (byte >= 016 && byte <= 0176))
-	{
-	  word = insert (word, byte, &bits);
-	}
-      else if (byte == 012)
-	{
-	  word = insert (word, 015, &bits);
-	  word = insert (word, 012, &bits);
-	}
-      else if (byte == 015)
-	{
-	  word = insert (word, 012, &bits);
-	}
-      else if (byte == 0177)
-	{
-	  word = insert (word, 0177, &bits);
-	  word = insert (word,    7, &bits);
-	}
-      else if ((byte >= 0200 && byte <= 0206) ||
-	       (byte >= 0210 && byte <= 0211) ||
-	       (byte >= 0213 && byte <= 0214) ||
-	       (byte >= 0216 && byte <= 0355))
-	{
-	  word = insert (word, 0177,        &bits);
-	  word = insert (word, byte - 0200, &bits);
-	}
-      else if (byte == 0207)
-	{
-	  word = insert (word, 0177, &bits);
-	  word = insert (word, 0177, &bits);
-	}
-      else if (byte == 0212)
-	{
-	  word = insert (word, 0177, &bits);
-	  word = insert (word,  015, &bits);
-	}
-      else if (byte == 0215)
-	{
-	  word = insert (word, 0177, &bits);
-	  word = insert (word,  012, &bits);
-	}
-      else if (byte == 0356)
-	{
-	  word = insert (word, 015, &bits);
-	}
-      else if (byte == 0357)
-	{
-	  word = insert (word, 0177, &bits);
-	}
-      else if (byte >= 0360)
+      if (d->n == 0)
 	{
 	  if (bits != 0)
-	    {
-	      fprintf (stderr, "[error in 36-bit file format]\n");
-	      exit (1);
-	    }
-	  word = byte & 017;
+	    format_error ();
+	  word = (d - decode) & 017;
 	  word = (word << 8) | get_byte (f);
 	  word = (word << 8) | get_byte (f);
 	  word = (word << 8) | get_byte (f);
 	  word = (word << 8) | get_byte (f);
-	  bits = 36;
+	  return word;
 	}
 
-      if (bits == 35)
+      word = (word << 7) | d->c[0];
+      bits += 7;
+      if (d->n == 2)
 	{
-	  word <<= 1;
-	  bits++;
+	  if (bits == 35)
+	    {
+	      word_context->its.leftover = d->c[1];
+	      word_context->its.have_leftover = 1;
+	      break;
+	    }
+	  word = (word << 7) | d->c[1];
+	  bits += 7;
 	}
-      else if (bits == 42)
+    }
+
+  return word << 1;
+}
+
+/* Decode words straight from a block of octets, as long as there are
+   enough octets left for a whole word.  Return the number of octets
+   used. */
+static size_t
+decode_block (const unsigned char *p, size_t size,
+	      word_t *buffer, size_t n, size_t *words)
+{
+  const unsigned char *start = p, *end = p + size;
+  const struct decode *d;
+  word_t word;
+  int bits;
+  size_t i;
+
+  for (i = 0; i < n && end - p >= WORD_OCTETS; i++)
+    {
+      word = 0;
+      bits = 0;
+
+      if (word_context->its.have_leftover)
 	{
-	  leftover = word & 0177;
-	  there_is_some_leftover = 1;
-	  word >>= 7;
-	  word <<= 1;
+	  word = word_context->its.leftover;
+	  bits = 7;
+	  word_context->its.have_leftover = 0;
 	}
+
+      while (bits < 35)
+	{
+	  d = &decode[*p++];
+	  if (d->n == 0)
+	    {
+	      if (bits != 0)
+		format_error ();
+	      word = (word_t)(p[-1] & 017) << 32 | (word_t)p[0] << 24 |
+		     (word_t)p[1] << 16 | (word_t)p[2] << 8 | p[3];
+	      p += 4;
+	      bits = 36;
+	      break;
+	    }
+
+	  word = (word << 7) | d->c[0];
+	  bits += 7;
+	  if (d->n == 2)
+	    {
+	      if (bits == 35)
+		{
+		  word_context->its.leftover = d->c[1];
+		  word_context->its.have_leftover = 1;
+		  break;
+		}
+	      word = (word << 7) | d->c[1];
+	      bits += 7;
+	    }
+	}
+
+      buffer[i] = bits == 36 ? word : word << 1;
     }
 
-  if (word > WORDMASK)
+  *words = i;
+  return p - start;
+}
+
+static size_t
+get_its_words (FILE *f, word_t *buffer, size_t n)
+{
+  unsigned char octets[BLOCK];
+  const unsigned char *p;
+  size_t i, k, used;
+
+  tables ();
+
+  for (i = 0; i < n; i += k)
     {
-      fprintf (stderr, "[error in 36-bit file format (word too large)]\n");
-      exit (1);
+      p = get_octet_block (f, octets, BLOCK);
+      if (p == NULL)
+        break;
+      used = decode_block (p, BLOCK, buffer + i, n - i, &k);
+      unget_octet_block (f, BLOCK - used);
     }
 
-  return word;
+  /* Less than a full block left, go word by word. */
+  for (; i < n; i++)
+    {
+      if ((buffer[i] = get_its_word (f)) == -1)
+        break;
+    }
+
+  return i;
 }
 
 static void
 rewind_its_word (FILE *f)
 {
-  there_is_some_leftover = 0;
-  output = -1;
-  rewind (f);
+  word_context->its.have_leftover = 0;
+  word_context->its.output = -1;
+  rewind_octet (f);
 }
 
-static void
-fputc2 (int c1, int c2, FILE *f)
+static int
+state (void)
 {
-  fputc (c1, f);
-  fputc (c2, f);
+  switch (word_context->its.previous_octet)
+    {
+    case 015:  return CR;
+    case 0177: return RUBOUT;
+    default:   return PLAIN;
+    }
 }
 
-static int previous_octet = -1;
-
 static void
 end_word (FILE *f)
 {
-  if (previous_octet == 015)
-    fputc (0356, f);
-  else if (previous_octet == 0177)
-    fputc (0357, f);
-  previous_octet = -1;
+  struct word_context *c = word_context;
+
+  if (c->its.previous_octet == 015)
+    putc_unlocked (0356, f);
+  else if (c->its.previous_octet == 0177)
+    putc_unlocked (0357, f);
+  c->its.previous_octet = -1;
 }
 
 static void
 binary_word (FILE *f, word_t word)
 {
+  unsigned char octets[5];
+
   end_word (f);
 
-  fputc (((word >> 32) &  017) + 0360, f);
-  fputc (((word >> 24) & 0377), f);
-  fputc (((word >> 16) & 0377), f);
-  fputc (((word >>  8) & 0377), f);
-  fputc (( word        & 0377), f);
+  octets[0] = ((word >> 32) &  017) + 0360;
+  octets[1] = ((word >> 24) & 0377);
+  octets[2] = ((word >> 16) & 0377);
+  octets[3] = ((word >>  8) & 0377);
+  octets[4] = ( word        & 0377);
+  fwrite (octets, 1, 5, f);
 }
 
 static void
 ascii_word (FILE *f, word_t word, int n)
 {
-  char c, octets[5];
-  int i;
+  static const int previous[STATES] = { -1, 015, 0177 };
+  unsigned char octets[2 * 5], *p = octets;
+  const struct encode *e;
+  int i, s;
 
-  octets[0] = (word >> 29) & 0177;
-  octets[1] = (word >> 22) & 0177;
-  octets[2] = (word >> 15) & 0177;
-  octets[3] = (word >>  8) & 0177;
-  octets[4] = (word >>  1) & 0177;
+  tables ();
 
+  s = state ();
   for (i = 0; i < n; i++)
     {
-      c = octets[i];
-
-      if (previous_octet == 015)
-	{
-	  if (c == 012)
-	    fputc (012, f);
-	  else if (c == 015)
-	    fputc2 (0356, 0356, f);
-	  else if (c == 0177)
-	    fputc2 (0356, 0357, f);
-	  else
-	    fputc2 (0356, c, f);
-	  previous_octet = -1;
-	}
-      else if (previous_octet == 0177)
-	{
-	  switch (c)
-	    {
-	    case 0007: fputc (0177, f); break;
-	    case 0012: fputc (0215, f); break;
-	    case 0015: fputc (0212, f); break;
-	    case 0177: fputc (0207, f); break;
-	    default:
-	      if (c < 0156)
-		fputc (c + 0200, f);
-	      else if (c == 012)
-		fputc2 (0357, 015, f);
-	      else if (c == 015)
-		fputc2 (0357, 0356, f);
-	      else if (c == 0177)
-		fputc2 (0357, 0357, f);
-	      else
-		fputc2 (0357, c, f);
-	      break;
-	    }
-	  previous_octet = -1;
-	}
-      else if (c == 015 || c == 0177)
-	previous_octet = c;
-      else if (c == 012)
-	fputc (015, f);
-      else
-	fputc (c, f);
+      e = &encode[s][(word >> (29 - 7 * i)) & 0177];
+      p[0] = e->octet[0];
+      p[1] = e->octet[1];
+      p += e->n;
+      s = e->state;
     }
+  word_context->its.previous_octet = previous[s];
+
+  if (p > octets)
+    fwrite (octets, 1, p - octets, f);
 }
 
 static int
@@ -274,32 +366,37 @@ characters (word_t word)
 static void
 flush_its_word (FILE *f)
 {
+  struct word_context *c = word_context;
+
   end_word (f);
-  if (output == -1)
+  if (c->its.output == -1)
     return;
-  if (output & 1)
-    binary_word (f, output);
+  if (c->its.output & 1)
+    binary_word (f, c->its.output);
   else
-    ascii_word (f, output, characters (output));
-  output = -1;
+    ascii_word (f, c->its.output, characters (c->its.output));
+  c->its.output = -1;
 }
 
 static void
 write_its_word (FILE *f, word_t word)
 {
-  if (output != -1)
+  struct word_context *c = word_context;
+
+  if (c->its.output != -1)
     {
-      if (output & 1)
-	binary_word (f, output);
+      if (c->its.output & 1)
+	binary_word (f, c->its.output);
       else
-	ascii_word (f, output, 5);
+	ascii_word (f, c->its.output, 5);
     }
-  output = word;
+  c->its.output = word;
 }
 
 struct word_format its_word_format = {
   "its",
   get_its_word,
+  get_its_words,
   rewind_its_word,
   NULL,
   write_its_word,
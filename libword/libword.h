@@ -21,6 +21,7 @@ typedef long long word_t;
 struct word_format {
   const char *name;
   word_t (*get_word) (FILE *);
+  size_t (*get_words) (FILE *, word_t *, size_t); /* NULL means loop get_word */
   void (*rewind_word) (FILE *);		/* NULL means just rewind (f) */
   void (*seek_word) (FILE *, int);	/* NULL means rewind and go forward. */
   void (*write_word) (FILE *, word_t);
@@ -33,8 +34,61 @@ enum {
   START_TAPE = 1LL << 38
 };
 
-extern struct word_format *input_word_format;
-extern struct word_format *output_word_format;
+/* Everything the word formats remember between calls.  Each thread
+   has a current context, which starts out as a shared default.  A
+   thread working on a file of its own should init and use a context
+   of its own. */
+struct word_context {
+  struct word_format *input_format;
+  struct word_format *output_format;
+  void (*tape_hook) (int code);		/* NULL means print on stderr. */
+  word_t checksum;
+
+  /* Memory mapped input file. */
+  FILE *mapped_file;
+  const unsigned char *mapped_data;
+  size_t mapped_size;
+  size_t mapped_position;
+  int mapped_eof;
+
+  struct {
+    word_t output;
+  } aa;
+  struct {
+    int leftover_input, have_leftover_input;
+    int leftover_output, have_leftover_output;
+  } bin;
+  struct {
+    int position;
+  } dta;
+  struct {
+    int leftover, have_leftover;
+    word_t output;
+    int previous_octet;
+  } its;
+  struct {
+    int leftover, have_leftover;
+    int carriage_return;
+  } sail;
+  struct {
+    struct tape_reader *reader;		/* Records read ahead. */
+    word_t *buffer;			/* Record being read. */
+    int n, words;
+    word_t bits;
+    int eof;
+    long offset;			/* Position of the record. */
+    unsigned long records;		/* Records read so far... */
+    double seconds;			/* ...in this time. */
+    word_t *record;			/* Record being written. */
+    int reclen;
+    int beginning_of_tape;
+    int marks;
+  } tape;
+};
+
+extern __thread struct word_context *word_context;
+
+
 extern struct word_format aa_word_format;
 extern struct word_format alto_word_format;
 extern struct word_format bin_word_format;
@@ -49,11 +103,15 @@ extern struct word_format sail_word_format;
 extern struct word_format tape_word_format;
 extern struct word_format tape7_word_format;
 
+extern void	init_word_context (struct word_context *context);
+extern void	free_word_context (struct word_context *context);
 extern void     usage_word_format (void);
 extern int      parse_input_word_format (const char *);
 extern int      parse_output_word_format (const char *);
 extern word_t	get_word (FILE *f);
+extern size_t	get_words (FILE *f, word_t *buffer, size_t n);
 extern word_t	get_checksummed_word (FILE *f);
+extern void	get_checksummed_words (FILE *f, word_t *buffer, size_t n);
 extern void	reset_checksum (word_t);
 extern void	check_checksum (word_t);
 extern void	rewind_word (FILE *f);
@@ -62,17 +120,35 @@ extern void	by_five_octets (FILE *f, int position);
 extern void	by_eight_octets (FILE *f, int position);
 extern void	write_word (FILE *, word_t);
 extern void	flush_word (FILE *);
-extern void     (*tape_hook) (int code);
 extern int      get_7track_record (FILE *f, word_t **buffer);
 extern int      get_9track_record (FILE *f, word_t **buffer);
 extern void     write_7track_record (FILE *f, word_t *buffer, int);
 extern void     write_9track_record (FILE *f, word_t *buffer, int);
+extern void	stop_tape_reader (struct word_context *context);
+extern void	report_tape_rate (FILE *f);
+extern long	tape_record_offset (FILE *f, unsigned long *record);
+extern void	seek_tape_record (FILE *f, long offset, unsigned long record);
 extern void     write_tape_mark (FILE *f);
 extern void     write_tape_eof (FILE *f);
 extern void     write_tape_eot (FILE *f);
 extern void     write_tape_gap (FILE *f, unsigned code);
 extern void     write_tape_error (FILE *f, unsigned code);
 extern word_t	get_core_word (FILE *f);
+extern int	select_unpack_kernel (const char *name);
+extern void	unpack_core (const unsigned char *, word_t *, size_t);
+extern void	unpack_bin (const unsigned char *, word_t *, size_t);
+extern void	unpack_dta (const unsigned char *, word_t *, size_t);
+extern int	map_word_input (FILE *f);
+extern void	unmap_word_input (FILE *f);
+extern int	get_octet (FILE *f);
+extern const unsigned char *get_octets (FILE *f, size_t n);
+extern const unsigned char *get_octet_block (FILE *f, unsigned char *buffer,
+					     size_t n);
+extern void	unget_octet_block (FILE *f, size_t n);
+extern int	eof_octet (FILE *f);
+extern void	rewind_octet (FILE *f);
+extern long	tell_octet (FILE *f);
+extern void	seek_octet (FILE *f, long position);
 extern void	write_core_word (FILE *f, word_t word);
 
 #endif /* LIBWORD_H */
@@ -20,10 +20,33 @@
 
 #include "libword.h"
 
+/* Like fgets, but reads through get_octet. */
+static char *
+get_line (char *line, int size, FILE *f)
+{
+  int c, i = 0;
+
+  while (i < size - 1)
+    {
+      c = get_octet (f);
+      if (c == EOF)
+        break;
+      line[i++] = c;
+      if (c == '\n')
+        break;
+    }
+
+  if (i == 0)
+    return NULL;
+
+  line[i] = 0;
+  return line;
+}
+
 static word_t
 get_oct_word (FILE *f)
 {
-  static char line[100];
+  char line[100];
   word_t word;
   char *p;
   int i;
@@ -31,7 +54,7 @@ get_oct_word (FILE *f)
   for (;;)
     {
     next:
-      p = fgets (line, sizeof line, f);
+      p = get_line (line, sizeof line, f);
       if (p == NULL)
         return -1;
 
@@ -65,6 +88,7 @@ struct word_format oct_word_format = {
   get_oct_word,
   NULL,
   NULL,
+  NULL,
   write_oct_word,
   NULL
 };
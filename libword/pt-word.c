@@ -26,7 +26,7 @@
 static int
 get_byte (FILE *f)
 {
-  int c = fgetc (f);
+  int c = get_octet (f);
   return c == EOF ? 0 : c;
 }
 
@@ -38,7 +38,7 @@ get_pt_word (FILE *f)
 
   for (i = 0; i < 6; )
     {
-      if (feof (f))
+      if (eof_octet (f))
         return -1;
 
       byte = get_byte (f);
@@ -56,12 +56,12 @@ get_pt_word (FILE *f)
 static void
 write_pt_word (FILE *f, word_t word)
 {
-  fputc (((word >> 30) & 0x3F) | 0x80, f);
-  fputc (((word >> 24) & 0x3F) | 0x80, f);
-  fputc (((word >> 18) & 0x3F) | 0x80, f);
-  fputc (((word >> 12) & 0x3F) | 0x80, f);
-  fputc (((word >>  6) & 0x3F) | 0x80, f);
-  fputc (( word        & 0x3F) | 0x80, f);
+  putc_unlocked (((word >> 30) & 0x3F) | 0x80, f);
+  putc_unlocked (((word >> 24) & 0x3F) | 0x80, f);
+  putc_unlocked (((word >> 18) & 0x3F) | 0x80, f);
+  putc_unlocked (((word >> 12) & 0x3F) | 0x80, f);
+  putc_unlocked (((word >>  6) & 0x3F) | 0x80, f);
+  putc_unlocked (( word        & 0x3F) | 0x80, f);
 }
 
 struct word_format pt_word_format = {
@@ -69,6 +69,7 @@ struct word_format pt_word_format = {
   get_pt_word,
   NULL,
   NULL,
+  NULL,
   write_pt_word,
   NULL
 };
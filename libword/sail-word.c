@@ -20,9 +20,6 @@
 #include <stdlib.h>
 #include "libword.h"
 
-static int leftover, there_is_some_leftover = 0;
-static int carriage_return = 0;
-
 #define WORDMASK	(0777777777777LL)
 #define SIGNBIT		(0400000000000LL)
 
@@ -65,7 +62,7 @@ static int sail (int c)
 static inline int
 get_byte (FILE *f)
 {
-  int c = fgetc (f);
+  int c = get_octet (f);
   return c == EOF ? 0 : c;
 }
 
@@ -83,23 +80,23 @@ get_sail_word (FILE *f)
   word_t word;
   int bits;
 
-  if (feof (f))
+  if (eof_octet (f))
     return -1;
 
   word = 0;
   bits = 0;
 
-  if (there_is_some_leftover)
+  if (word_context->sail.have_leftover)
     {
-      word = leftover;
+      word = word_context->sail.leftover;
       bits = 7;
-      there_is_some_leftover = 0;
+      word_context->sail.have_leftover = 0;
     }
 
   while (bits < 36)
     {
       byte = get_byte (f);
-      if (feof (f))
+      if (eof_octet (f))
 	{
 	  if (bits == 0)
 	    return -1;
@@ -160,8 +157,8 @@ get_sail_word (FILE *f)
 	}
       else if (bits == 42)
 	{
-	  leftover = word & 0177;
-	  there_is_some_leftover = 1;
+	  word_context->sail.leftover = word & 0177;
+	  word_context->sail.have_leftover = 1;
 	  word >>= 7;
 	  word <<= 1;
 	}
@@ -179,8 +176,8 @@ get_sail_word (FILE *f)
 static void
 rewind_sail_word (FILE *f)
 {
-  there_is_some_leftover = 0;
-  rewind (f);
+  word_context->sail.have_leftover = 0;
+  rewind_octet (f);
 }
 
 static void
@@ -188,24 +185,24 @@ write_utf8 (FILE *f, unsigned c)
 {
   if (c >= 0x10000)
     {
-      fputc ((c >> 18) | 0xE0, f);
-      fputc (((c >> 12) & 0x3F) | 0x80, f);
-      fputc (((c >> 6) & 0x3F) | 0x80, f);
-      fputc ((c & 0x03F) | 0x80, f);
+      putc_unlocked ((c >> 18) | 0xE0, f);
+      putc_unlocked (((c >> 12) & 0x3F) | 0x80, f);
+      putc_unlocked (((c >> 6) & 0x3F) | 0x80, f);
+      putc_unlocked ((c & 0x03F) | 0x80, f);
     }
   else if (c >= 0x800)
     {
-      fputc ((c >> 12) | 0xE0, f);
-      fputc (((c >> 6) & 0x3F) | 0x80, f);
-      fputc ((c & 0x03F) | 0x80, f);
+      putc_unlocked ((c >> 12) | 0xE0, f);
+      putc_unlocked (((c >> 6) & 0x3F) | 0x80, f);
+      putc_unlocked ((c & 0x03F) | 0x80, f);
     }
   else if (c >= 0x80)
     {
-      fputc ((c >> 6) | 0xC0, f);
-      fputc ((c & 0x3F) | 0x80, f);
+      putc_unlocked ((c >> 6) | 0xC0, f);
+      putc_unlocked ((c & 0x3F) | 0x80, f);
     }
   else
-    fputc (c, f);
+    putc_unlocked (c, f);
 }
 
 static int unsail (int c)
@@ -248,21 +245,24 @@ static int unsail (int c)
 static void
 write_char (FILE *f, char c)
 {
-  if (carriage_return)
+  if (word_context->sail.carriage_return)
     {
       if (c == 012)
-	fputc ('\n', f);
+	putc_unlocked ('\n', f);
       else
-	fputc (015, f);
+	putc_unlocked (015, f);
     }
   switch (c)
     {
     case 0000: break;
-    case 0012: if (!carriage_return) fputc (012, f); break;
-    case 0015: carriage_return = 1; break;
+    case 0012:
+      if (!word_context->sail.carriage_return)
+	putc_unlocked (012, f);
+      break;
+    case 0015: word_context->sail.carriage_return = 1; break;
     default:   write_utf8 (f, unsail (c)); break;
     }
-  carriage_return = (c == 015);
+  word_context->sail.carriage_return = (c == 015);
 }
 
 static void
@@ -286,14 +286,15 @@ write_sail_word (FILE *f, word_t word)
 static void
 flush_sail_word (FILE *f)
 {
-  if (carriage_return)
-    fputc (015, f);
-  carriage_return = 0;
+  if (word_context->sail.carriage_return)
+    putc_unlocked (015, f);
+  word_context->sail.carriage_return = 0;
 }
 
 struct word_format sail_word_format = {
   "sail",
   get_sail_word,
+  NULL,
   rewind_sail_word,
   NULL,
   write_sail_word,
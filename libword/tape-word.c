@@ -15,23 +15,55 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
 #include "libword.h"
 
-/* Buffer for write_word. */
-static word_t record[65536];
-static int reclen = 0;
-static int beginning_of_tape = 1;
-static int marks = 0;
+/* Size of the buffer for write_word. */
+#define RECORD_WORDS 65536
 
-static void tape_special (int code);
-static int get_tape_record (FILE *f, word_t **buffer);
+/* Records are read ahead by a separate thread into a ring of slots,
+   while get_tape_word hands out words from the oldest one.  The slots
+   grow to fit the largest record seen, so there is no limit on the
+   record size.  An error in the image is passed on in a slot of its
+   own, so it's reported in order by the thread using the words. */
+#define TAPE_SLOTS 4
+
+enum { RECORD_DATA, RECORD_MARK, RECORD_SPECIAL, RECORD_EOF, RECORD_ERROR };
 
-void (*tape_hook) (int code) = tape_special;
+struct tape_slot
+{
+  int type;
+  long offset;			/* Position in the tape image. */
+  int words;			/* Or the code of a special record. */
+  word_t *data;
+  size_t size;
+  unsigned char *octets;	/* Used when reading through stdio. */
+  size_t octets_size;
+  char message[100];		/* For an error. */
+};
+
+struct tape_reader
+{
+  FILE *f;
+  int track;
+  struct word_context *context;
+  struct tape_slot slot[TAPE_SLOTS];
+  int head, count;
+  int stop;
+  struct timespec start;
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+};
+
+static void tape_special (int code);
 
 static int
 get_byte (FILE *f)
 {
-  int c = fgetc (f);
+  int c = get_octet (f);
   return c == EOF ? 0 : c;
 }
 
@@ -40,7 +72,7 @@ get_7track_word (FILE *f)
 {
   word_t word;
 
-  if (feof (f))
+  if (eof_octet (f))
     return -1;
 
   word = (((word_t)get_byte (f) & 077) << 30) |
@@ -63,7 +95,7 @@ write_7track_word (FILE *f, word_t word)
       c = (word >> 30) & 077;
       p = 0100 ^ (c << 1) ^ (c << 2) ^ (c << 3) ^ (c << 4) ^ (c << 5) ^ (c << 6);
       c |= p & 0100;
-      fputc (c, f);
+      putc_unlocked (c, f);
       word <<= 6;
     }
 }
@@ -78,19 +110,25 @@ static int get_reclen (FILE *f)
 
 static void write_reclen (FILE *f, int n)
 {
-  fputc (n & 0377, f);
-  fputc ((n >> 8) & 0377, f);
-  fputc ((n >> 16) & 0377, f);
-  fputc ((n >> 24) & 0377, f);
+  putc_unlocked (n & 0377, f);
+  putc_unlocked ((n >> 8) & 0377, f);
+  putc_unlocked ((n >> 16) & 0377, f);
+  putc_unlocked ((n >> 24) & 0377, f);
 
   if (n == 0)
-    marks++;
+    word_context->tape.marks++;
   else
-    marks = 0;
+    word_context->tape.marks = 0;
 }
 
 static void tape_special (int code)
 {
+  if (word_context->tape_hook != NULL)
+    {
+      word_context->tape_hook (code);
+      return;
+    }
+
   switch ((code >> 24) & 0xFF)
     {
     case 0x80:
@@ -105,204 +143,343 @@ static void tape_special (int code)
     }
 }
 
-int get_9track_record (FILE *f, word_t **buffer)
+static void *
+xrealloc (void *ptr, size_t size)
 {
-  int i, x, reclen;
-  word_t *p;
+  ptr = realloc (ptr, size);
+  if (ptr == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  return ptr;
+}
 
-  reclen = get_reclen (f);
+/* Read one record, tape mark, or special record into a slot. */
+static void
+read_record (FILE *f, int track, struct tape_slot *s)
+{
+  const unsigned char *p;
+  int i, x, reclen, size;
+
+  reclen = get_octet (f);
+  if (reclen == EOF)
+    {
+      s->type = RECORD_EOF;
+      s->words = 0;
+      return;
+    }
+  reclen |= (get_byte (f) << 8) | (get_byte (f) << 16) | (get_byte (f) << 24);
+
+  s->words = 0;
   if (reclen == 0)
-    return 0;
+    {
+      s->type = RECORD_MARK;
+      return;
+    }
   else if (reclen & 0x80000000)
     {
-      tape_hook (reclen);
-      return get_tape_record (f, buffer);
+      s->type = RECORD_SPECIAL;
+      s->words = reclen;
+      return;
     }
 
-  if (reclen % 5)
+  size = track == 9 ? 5 : 6;
+  if (reclen % size)
     {
-      fprintf (stderr, "Not a CORE DUMP tape image.\n"
-	       "reclen = %d\n", reclen);
-      exit (1);
+      s->type = RECORD_ERROR;
+      snprintf (s->message, sizeof s->message,
+		"Not a %s tape image.\nreclen = %d\n",
+		track == 9 ? "CORE DUMP" : "7-track", reclen);
+      return;
     }
-  
-  *buffer = malloc (sizeof (word_t) * (reclen/5));
-  if (*buffer == NULL)
+
+  s->type = RECORD_DATA;
+  s->words = reclen / size;
+  if ((size_t)s->words > s->size)
     {
-      fprintf (stderr, "Out of memory.\n");
-      exit (1);
+      s->size = s->words;
+      s->data = xrealloc (s->data, s->size * sizeof (word_t));
     }
 
-  for (i = 0, p = *buffer; i < (reclen / 5); i++)
-    *p++ = get_core_word (f);
+  if (track == 9)
+    {
+      if ((size_t)reclen > s->octets_size)
+	{
+	  s->octets_size = reclen;
+	  s->octets = xrealloc (s->octets, s->octets_size);
+	}
+      p = get_octet_block (f, s->octets, reclen);
+      if (p == NULL)
+	{
+	  for (i = 0; i < reclen; i++)
+	    s->octets[i] = get_byte (f);
+	  p = s->octets;
+	}
+      unpack_core (p, s->data, s->words);
+    }
+  else
+    {
+      for (i = 0; i < s->words; i++)
+	s->data[i] = get_7track_word (f);
+    }
 
   /* First try the E-11 tape format. */
   x = get_reclen (f);
-  if (x != reclen)
+  if (x != reclen && track == 9)
     {
       /* Next try the SIMH tape format. */
       if (reclen & 1)
 	x = (x >> 8) + (get_byte (f) << 24);
-
-      if (x != reclen)
-	{
-	  fprintf (stderr, "Error in tape image format.\n"
-		   "%d != %d\n", reclen, x);
-	  exit (1);
-	}
     }
 
-  if (reclen == 0)
+  if (x != reclen)
     {
-      free (*buffer);
+      s->type = RECORD_ERROR;
+      snprintf (s->message, sizeof s->message,
+		"Error in tape image format.\n%d != %d\n", reclen, x);
     }
-
-  return reclen / 5;
 }
 
-void write_7track_record (FILE *f, word_t *buffer, int n)
+static void
+record_error (struct tape_slot *s)
 {
-  int i;
-
-  write_reclen (f, 6 * n);
-  if (n == 0)
-    return;
-  
-  for (i = 0; i < n; i++)
-    write_7track_word (f, *buffer++);
-
-  write_reclen (f, 6 * n);
+  fputs (s->message, stderr);
+  exit (1);
 }
 
-void write_9track_record (FILE *f, word_t *buffer, int n)
+/* Read a record synchronously, passing special records to the hook.
+   Return the number of words, or 0 for a tape mark or the end. */
+static int
+get_record (FILE *f, int track, word_t **buffer)
 {
-  int i;
+  struct tape_slot s;
 
-  /* To write a tape record in the SIMH tape image format, first write
-     a 32-bit record length, then data frames, then the length again.
-     For PDP-10 36-bit data, the data words are written in the "core
-     dump" format.  One word is written as five 8-bit frames, with
-     four bits unused in the last frame. */
-
-  write_reclen (f, 5 * n);
+  memset (&s, 0, sizeof s);
+  for (;;)
+    {
+      read_record (f, track, &s);
+      if (s.type == RECORD_ERROR)
+	record_error (&s);
+      if (s.type != RECORD_SPECIAL)
+	break;
+      tape_special (s.words);
+    }
 
-  /* A record of length zero is a tape mark, and the length is only
-     written once. */
-  if (n == 0)
-    return;
-  
-  for (i = 0; i < n; i++)
-    write_core_word (f, *buffer++);
+  free (s.octets);
+  if (s.type != RECORD_DATA)
+    {
+      free (s.data);
+      return 0;
+    }
 
-  /* Pad out to make the record data an even number of octets. */
-  if ((n * 5) & 1)
-    fputc (0, f);
+  *buffer = s.data;
+  return s.words;
+}
 
-  write_reclen (f, 5 * n);
+int get_9track_record (FILE *f, word_t **buffer)
+{
+  return get_record (f, 9, buffer);
 }
 
 int get_7track_record (FILE *f, word_t **buffer)
 {
-  int i, x, reclen;
-  word_t *p;
+  return get_record (f, 7, buffer);
+}
 
-  reclen = get_reclen (f);
-  if (reclen == 0)
-    return 0;
-  else if (reclen & 0x80000000)
-    {
-      tape_hook (reclen);
-      return get_tape_record (f, buffer);
-    }
+static void *
+tape_reader (void *arg)
+{
+  struct tape_reader *r = arg;
+  struct tape_slot *s;
+  int type;
 
-  if (reclen % 6)
-    {
-      fprintf (stderr, "Not a 7-track tape image.\n"
-	       "reclen = %d\n", reclen);
-      exit (1);
-    }
-  
-  *buffer = malloc (sizeof (word_t) * (reclen/6));
-  if (*buffer == NULL)
+  /* Use the owner's context, for a memory mapped input. */
+  word_context = r->context;
+
+  do
     {
-      fprintf (stderr, "Out of memory.\n");
-      exit (1);
+      pthread_mutex_lock (&r->lock);
+      while (r->count == TAPE_SLOTS && !r->stop)
+	pthread_cond_wait (&r->cond, &r->lock);
+      if (r->stop)
+	{
+	  pthread_mutex_unlock (&r->lock);
+	  return NULL;
+	}
+      s = &r->slot[(r->head + r->count) % TAPE_SLOTS];
+      pthread_mutex_unlock (&r->lock);
+
+      s->offset = tell_octet (r->f);
+      read_record (r->f, r->track, s);
+      type = s->type;
+
+      pthread_mutex_lock (&r->lock);
+      r->count++;
+      pthread_cond_broadcast (&r->cond);
+      pthread_mutex_unlock (&r->lock);
     }
+  while (type != RECORD_EOF && type != RECORD_ERROR);
 
-  for (i = 0, p = *buffer; i < (reclen / 6); i++)
-    *p++ = get_7track_word (f);
+  return NULL;
+}
 
-  x = get_reclen (f);
-  if (x != reclen)
+static void
+start_reader (struct word_context *c, FILE *f)
+{
+  struct tape_reader *r;
+
+  r = xrealloc (NULL, sizeof *r);
+  memset (r, 0, sizeof *r);
+  r->f = f;
+  r->track = c->input_format == &tape_word_format ? 9 : 7;
+  r->context = c;
+  pthread_mutex_init (&r->lock, NULL);
+  pthread_cond_init (&r->cond, NULL);
+  clock_gettime (CLOCK_MONOTONIC, &r->start);
+  if (pthread_create (&r->thread, NULL, tape_reader, r) != 0)
     {
-      fprintf (stderr, "Error in tape image format.\n"
-	       "%d != %d\n", reclen, x);
+      fprintf (stderr, "Error creating thread.\n");
       exit (1);
     }
 
-  if (reclen == 0)
+  c->tape.reader = r;
+}
+
+void
+stop_tape_reader (struct word_context *c)
+{
+  struct tape_reader *r = c->tape.reader;
+  struct timespec now;
+  int i;
+
+  if (r == NULL)
+    return;
+
+  pthread_mutex_lock (&r->lock);
+  r->stop = 1;
+  pthread_cond_broadcast (&r->cond);
+  pthread_mutex_unlock (&r->lock);
+  pthread_join (r->thread, NULL);
+
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  c->tape.seconds += (now.tv_sec - r->start.tv_sec)
+    + (now.tv_nsec - r->start.tv_nsec) / 1e9;
+
+  for (i = 0; i < TAPE_SLOTS; i++)
     {
-      free (*buffer);
+      free (r->slot[i].data);
+      free (r->slot[i].octets);
     }
-
-  return reclen / 6;
+  pthread_mutex_destroy (&r->lock);
+  pthread_cond_destroy (&r->cond);
+  free (r);
+  c->tape.reader = NULL;
+  c->tape.buffer = NULL;
 }
 
-static word_t *buffer = NULL;
-static int n, words;
-static word_t tape_bits = START_FILE;
+static void
+release_slot (struct tape_reader *r)
+{
+  pthread_mutex_lock (&r->lock);
+  r->head = (r->head + 1) % TAPE_SLOTS;
+  r->count--;
+  pthread_cond_broadcast (&r->cond);
+  pthread_mutex_unlock (&r->lock);
+}
 
+/* Get the next record read ahead.  Return the number of words, or 0
+   for a tape mark or the end of the input.  The slot holding a record
+   is released when all its words have been handed out. */
 static int
-get_tape_record (FILE *f, word_t **buffer)
+next_record (struct word_context *c, FILE *f)
 {
-  if (input_word_format == &tape_word_format)
-    return get_9track_record (f, buffer);
-  else
-    return get_7track_record (f, buffer);
+  struct tape_reader *r;
+  struct tape_slot *s;
+
+  if (c->tape.eof)
+    return 0;
+  if (c->tape.reader != NULL && c->tape.reader->f != f)
+    stop_tape_reader (c);
+  if (c->tape.reader == NULL)
+    start_reader (c, f);
+  r = c->tape.reader;
+
+  for (;;)
+    {
+      pthread_mutex_lock (&r->lock);
+      while (r->count == 0)
+	pthread_cond_wait (&r->cond, &r->lock);
+      s = &r->slot[r->head];
+      pthread_mutex_unlock (&r->lock);
+
+      switch (s->type)
+	{
+	case RECORD_DATA:
+	  c->tape.records++;
+	  c->tape.offset = s->offset;
+	  c->tape.buffer = s->data;
+	  return s->words;
+	case RECORD_MARK:
+	  release_slot (r);
+	  return 0;
+	case RECORD_SPECIAL:
+	  tape_special (s->words);
+	  release_slot (r);
+	  break;
+	case RECORD_EOF:
+	  stop_tape_reader (c);
+	  c->tape.eof = 1;
+	  return 0;
+	case RECORD_ERROR:
+	  record_error (s);
+	}
+    }
 }
 
 static word_t
 get_tape_word (FILE *f)
 {
+  struct word_context *c = word_context;
   word_t word;
 
-  if (buffer == NULL)
+  if (c->tape.buffer == NULL)
     {
-      words = get_tape_record (f, &buffer);
-      if (words == 0)
+      c->tape.words = next_record (c, f);
+      if (c->tape.words == 0)
 	{
 	  /* Seen one tape mark.  Is this EOF or EOT? */
-	  words = get_tape_record (f, &buffer);
-	  if (words == 0)
+	  c->tape.words = next_record (c, f);
+	  if (c->tape.words == 0)
 	    {
-	      while (words == 0)
+	      while (c->tape.words == 0)
 		{
 		  /* Seen two or more tape marks.  Is this pysical or
 		     logical EOT? */
-		  words = get_tape_record (f, &buffer);
-		  if (feof (f))
+		  c->tape.words = next_record (c, f);
+		  if (c->tape.eof)
 		    /* End of input file means physical end of tape. */
 		    return -1;
 		}
 	      /* More data in input file; it was logical end of tape. */
-	      tape_bits = START_TAPE;
+	      c->tape.bits = START_TAPE;
 	    }
 	  else
-	    tape_bits = START_FILE;
+	    c->tape.bits = START_FILE;
 	}
-      else if (tape_bits == 0)
-	tape_bits = START_RECORD;
-      n = 0;
+      else if (c->tape.bits == 0)
+	c->tape.bits = START_RECORD;
+      c->tape.n = 0;
     }
 
-  word = buffer[n++];
-  word |= tape_bits;
-  tape_bits = 0;
+  word = c->tape.buffer[c->tape.n++];
+  word |= c->tape.bits;
+  c->tape.bits = 0;
 
-  if (n == words)
+  if (c->tape.n == c->tape.words)
     {
-      free (buffer);
-      buffer = NULL;
+      c->tape.buffer = NULL;
+      release_slot (c->tape.reader);
     }
 
   return word;
@@ -311,17 +488,106 @@ get_tape_word (FILE *f)
 static void
 rewind_tape_word (FILE *f)
 {
-  if (buffer != NULL)
-    free (buffer);
-  tape_bits = START_FILE;
-  buffer = NULL;
-  rewind (f);
+  stop_tape_reader (word_context);
+  word_context->tape.eof = 0;
+  word_context->tape.bits = START_FILE;
+  word_context->tape.records = 0;
+  word_context->tape.seconds = 0;
+  rewind_octet (f);
+}
+
+/* Return the position in the tape image of the record holding the last
+   word read, and its number counting from 1.  The position is -1 if
+   the input isn't seekable. */
+long
+tape_record_offset (FILE *f, unsigned long *record)
+{
+  (void)f;
+  *record = word_context->tape.records;
+  return word_context->tape.offset;
+}
+
+/* Go to a record found by tape_record_offset.  The next word read is
+   the first in that record. */
+void
+seek_tape_record (FILE *f, long offset, unsigned long record)
+{
+  stop_tape_reader (word_context);
+  word_context->tape.eof = 0;
+  word_context->tape.bits = 0;
+  word_context->tape.records = record - 1;
+  seek_octet (f, offset);
+}
+
+/* Print how fast tape records have been read, if any were. */
+void
+report_tape_rate (FILE *f)
+{
+  struct word_context *c = word_context;
+  struct timespec now;
+  double seconds = c->tape.seconds;
+
+  if (c->tape.records == 0)
+    return;
+
+  if (c->tape.reader != NULL)
+    {
+      clock_gettime (CLOCK_MONOTONIC, &now);
+      seconds += (now.tv_sec - c->tape.reader->start.tv_sec)
+	+ (now.tv_nsec - c->tape.reader->start.tv_nsec) / 1e9;
+    }
+
+  fprintf (f, "%lu records in %.3f seconds", c->tape.records, seconds);
+  if (seconds > 0)
+    fprintf (f, ", %.0f records/s", c->tape.records / seconds);
+  fprintf (f, ".\n");
+}
+
+void write_7track_record (FILE *f, word_t *buffer, int n)
+{
+  int i;
+
+  write_reclen (f, 6 * n);
+  if (n == 0)
+    return;
+  
+  for (i = 0; i < n; i++)
+    write_7track_word (f, *buffer++);
+
+  write_reclen (f, 6 * n);
+}
+
+void write_9track_record (FILE *f, word_t *buffer, int n)
+{
+  int i;
+
+  /* To write a tape record in the SIMH tape image format, first write
+     a 32-bit record length, then data frames, then the length again.
+     For PDP-10 36-bit data, the data words are written in the "core
+     dump" format.  One word is written as five 8-bit frames, with
+     four bits unused in the last frame. */
+
+  write_reclen (f, 5 * n);
+
+  /* A record of length zero is a tape mark, and the length is only
+     written once. */
+  if (n == 0)
+    return;
+  
+  for (i = 0; i < n; i++)
+    write_core_word (f, *buffer++);
+
+  /* Pad out to make the record data an even number of octets. */
+  if ((n * 5) & 1)
+    putc_unlocked (0, f);
+
+  write_reclen (f, 5 * n);
 }
 
 static void
 write_tape_record (FILE *f, word_t *buffer, int n)
 {
-  if (output_word_format == &tape_word_format)
+  if (word_context->output_format == &tape_word_format)
     write_9track_record (f, buffer, n);
   else
     write_7track_record (f, buffer, n);
@@ -336,14 +602,14 @@ write_tape_mark (FILE *f)
 void
 write_tape_eof (FILE *f)
 {
-  while (marks < 1)
+  while (word_context->tape.marks < 1)
     write_tape_mark (f);
 }
 
 void
 write_tape_eot (FILE *f)
 {
-  while (marks < 2)
+  while (word_context->tape.marks < 2)
     write_tape_mark (f);
 }
 
@@ -362,14 +628,16 @@ write_tape_error (FILE *f, unsigned code)
 static void
 flush_record (FILE *f)
 {
-  write_tape_record (f, record, reclen);
-  reclen = 0;
+  write_tape_record (f, word_context->tape.record, word_context->tape.reclen);
+  word_context->tape.reclen = 0;
 }
 
 static void
 write_tape_word (FILE *f, word_t word)
 {
-  if (!beginning_of_tape)
+  struct word_context *c = word_context;
+
+  if (!c->tape.beginning_of_tape)
     {
       if (word & (START_RECORD|START_FILE|START_TAPE))
 	flush_record (f);
@@ -378,15 +646,25 @@ write_tape_word (FILE *f, word_t word)
       if (word & START_TAPE)
 	write_tape_eot (f);
     }
-  beginning_of_tape = 0;
+  c->tape.beginning_of_tape = 0;
+
+  if (c->tape.record == NULL)
+    {
+      c->tape.record = malloc (RECORD_WORDS * sizeof (word_t));
+      if (c->tape.record == NULL)
+	{
+	  fprintf (stderr, "Out of memory.\n");
+	  exit (1);
+	}
+    }
 
-  if (reclen == sizeof record)
+  if (c->tape.reclen == RECORD_WORDS)
     {
       fprintf (stderr, "Output tape record too large.\n");
       exit (1);
     }
 
-  record[reclen++] = word;
+  c->tape.record[c->tape.reclen++] = word;
 }
 
 static void
@@ -394,13 +672,14 @@ flush_tape_word (FILE *f)
 {
   flush_record (f);
   write_tape_eot (f);
-  beginning_of_tape = 1;
-  marks = 0;
+  word_context->tape.beginning_of_tape = 1;
+  word_context->tape.marks = 0;
 }
 
 struct word_format tape_word_format = {
   "tape",
   get_tape_word,
+  NULL,
   rewind_tape_word,
   NULL,
   write_tape_word,
@@ -410,6 +689,7 @@ struct word_format tape_word_format = {
 struct word_format tape7_word_format = {
   "tape7",
   get_tape_word,
+  NULL,
   rewind_tape_word,
   NULL,
   write_tape_word,
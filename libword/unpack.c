@@ -0,0 +1,298 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Unpack blocks of octets into 36-bit words, for the bulk decoders in
+   the core, bin, and dta word formats.  There are plain C kernels,
+   and on x86 also SSE and AVX2 kernels which are selected at run
+   time depending on what the CPU supports.  The vector kernels are
+   only built when optimizing; without it the intrinsics are much
+   slower than the plain C. */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "libword.h"
+
+#if defined(__GNUC__) && defined(__OPTIMIZE__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define X86_KERNELS
+#include <immintrin.h>
+#endif
+
+/* Core dump format, five octets per word.  The last octet is ORed
+   in, just like get_core_word does. */
+static void
+unpack_core_scalar (const unsigned char *p, word_t *word, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++, p += 5)
+    word[i] = ((word_t)p[0] << 28) | ((word_t)p[1] << 20) |
+              ((word_t)p[2] << 12) | ((word_t)p[3] <<  4) |
+               (word_t)p[4];
+}
+
+/* Bin format, two words in nine octets.  The count is in pairs. */
+static void
+unpack_bin_scalar (const unsigned char *p, word_t *word, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++, p += 9, word += 2)
+    {
+      word[0] = (word_t)p[0] << 28 | (word_t)p[1] << 20 |
+                (word_t)p[2] << 12 | (word_t)p[3] << 4 | (word_t)p[4] >> 4;
+      word[1] = (word_t)(p[4] & 0x0f) << 32 | (word_t)p[5] << 24 |
+                (word_t)p[6] << 16 | (word_t)p[7] << 8 | (word_t)p[8];
+    }
+}
+
+/* DECtape format, two 32-bit little endian halves per word.  Like
+   get_dta_word, the halves are treated as signed. */
+static void
+unpack_dta_scalar (const unsigned char *p, word_t *word, size_t n)
+{
+  int32_t left, right;
+  size_t i;
+
+  for (i = 0; i < n; i++, p += 8)
+    {
+      left = (int32_t)((uint32_t)p[0] | (uint32_t)p[1] << 8 |
+                       (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+      right = (int32_t)((uint32_t)p[4] | (uint32_t)p[5] << 8 |
+                        (uint32_t)p[6] << 16 | (uint32_t)p[7] << 24);
+      word[i] = (word_t)left * (1 << 18) + right;
+    }
+}
+
+#ifdef X86_KERNELS
+
+/* Move octets 3-0 and 8-5 into the low half of each 64-bit lane, and
+   octets 4 and 9 into the lowest octet. */
+#define CORE_HIGH 3, 2, 1, 0, -1, -1, -1, -1, 8, 7, 6, 5, -1, -1, -1, -1
+#define CORE_LOW  4, -1, -1, -1, -1, -1, -1, -1, 9, -1, -1, -1, -1, -1, -1, -1
+
+/* Move octets 4-0 into the first lane, and 8-4 into the second. */
+#define BIN_PAIR  4, 3, 2, 1, 0, -1, -1, -1, 8, 7, 6, 5, 4, -1, -1, -1
+
+__attribute__ ((target ("ssse3")))
+static void
+unpack_core_sse (const unsigned char *p, word_t *word, size_t n)
+{
+  const __m128i high = _mm_setr_epi8 (CORE_HIGH);
+  const __m128i low = _mm_setr_epi8 (CORE_LOW);
+  __m128i x;
+  size_t i;
+
+  /* Each load is 16 octets, of which 10 are used. */
+  for (i = 0; i + 3 < n; i += 2, p += 10)
+    {
+      x = _mm_loadu_si128 ((const __m128i *)p);
+      x = _mm_or_si128 (_mm_slli_epi64 (_mm_shuffle_epi8 (x, high), 4),
+                        _mm_shuffle_epi8 (x, low));
+      _mm_storeu_si128 ((__m128i *)(word + i), x);
+    }
+
+  unpack_core_scalar (p, word + i, n - i);
+}
+
+__attribute__ ((target ("ssse3")))
+static void
+unpack_bin_sse (const unsigned char *p, word_t *word, size_t n)
+{
+  const __m128i pair = _mm_setr_epi8 (BIN_PAIR);
+  const __m128i first = _mm_set_epi64x (0, 0777777777777LL);
+  const __m128i second = _mm_set_epi64x (0777777777777LL, 0);
+  __m128i x;
+  size_t i;
+
+  /* Each load is 16 octets, of which 9 are used. */
+  for (i = 0; i + 1 < n; i++, p += 9)
+    {
+      x = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *)p), pair);
+      x = _mm_or_si128 (_mm_and_si128 (_mm_srli_epi64 (x, 4), first),
+                        _mm_and_si128 (x, second));
+      _mm_storeu_si128 ((__m128i *)(word + 2 * i), x);
+    }
+
+  unpack_bin_scalar (p, word + 2 * i, n - i);
+}
+
+__attribute__ ((target ("sse4.1")))
+static void
+unpack_dta_sse (const unsigned char *p, word_t *word, size_t n)
+{
+  __m128i x, left, right;
+  size_t i;
+
+  for (i = 0; i + 2 <= n; i += 2, p += 16)
+    {
+      x = _mm_loadu_si128 ((const __m128i *)p);
+      left = _mm_cvtepi32_epi64 (_mm_shuffle_epi32 (x, 0x08));
+      right = _mm_cvtepi32_epi64 (_mm_shuffle_epi32 (x, 0x0D));
+      x = _mm_add_epi64 (_mm_slli_epi64 (left, 18), right);
+      _mm_storeu_si128 ((__m128i *)(word + i), x);
+    }
+
+  unpack_dta_scalar (p, word + i, n - i);
+}
+
+__attribute__ ((target ("avx2")))
+static void
+unpack_core_avx2 (const unsigned char *p, word_t *word, size_t n)
+{
+  const __m256i high = _mm256_setr_epi8 (CORE_HIGH, CORE_HIGH);
+  const __m256i low = _mm256_setr_epi8 (CORE_LOW, CORE_LOW);
+  __m256i x;
+  size_t i;
+
+  /* Two 16-octet loads, each lane holding two words. */
+  for (i = 0; i + 6 <= n; i += 4, p += 20)
+    {
+      x = _mm256_inserti128_si256 (_mm256_castsi128_si256 (
+            _mm_loadu_si128 ((const __m128i *)p)),
+            _mm_loadu_si128 ((const __m128i *)(p + 10)), 1);
+      x = _mm256_or_si256 (_mm256_slli_epi64 (_mm256_shuffle_epi8 (x, high), 4),
+                           _mm256_shuffle_epi8 (x, low));
+      _mm256_storeu_si256 ((__m256i *)(word + i), x);
+    }
+
+  unpack_core_sse (p, word + i, n - i);
+}
+
+__attribute__ ((target ("avx2")))
+static void
+unpack_bin_avx2 (const unsigned char *p, word_t *word, size_t n)
+{
+  const __m256i pair = _mm256_setr_epi8 (BIN_PAIR, BIN_PAIR);
+  const __m256i mask = _mm256_set1_epi64x (0777777777777LL);
+  const __m256i shift = _mm256_setr_epi64x (4, 0, 4, 0);
+  __m256i x;
+  size_t i;
+
+  /* Two 16-octet loads, each lane holding a pair of words. */
+  for (i = 0; i + 2 < n; i += 2, p += 18)
+    {
+      x = _mm256_inserti128_si256 (_mm256_castsi128_si256 (
+            _mm_loadu_si128 ((const __m128i *)p)),
+            _mm_loadu_si128 ((const __m128i *)(p + 9)), 1);
+      x = _mm256_shuffle_epi8 (x, pair);
+      x = _mm256_and_si256 (_mm256_srlv_epi64 (x, shift), mask);
+      _mm256_storeu_si256 ((__m256i *)(word + 2 * i), x);
+    }
+
+  unpack_bin_sse (p, word + 2 * i, n - i);
+}
+
+__attribute__ ((target ("avx2")))
+static void
+unpack_dta_avx2 (const unsigned char *p, word_t *word, size_t n)
+{
+  const __m256i halves = _mm256_setr_epi32 (0, 2, 4, 6, 1, 3, 5, 7);
+  __m256i x, left, right;
+  size_t i;
+
+  for (i = 0; i + 4 <= n; i += 4, p += 32)
+    {
+      x = _mm256_loadu_si256 ((const __m256i *)p);
+      x = _mm256_permutevar8x32_epi32 (x, halves);
+      left = _mm256_cvtepi32_epi64 (_mm256_castsi256_si128 (x));
+      right = _mm256_cvtepi32_epi64 (_mm256_extracti128_si256 (x, 1));
+      x = _mm256_add_epi64 (_mm256_slli_epi64 (left, 18), right);
+      _mm256_storeu_si256 ((__m256i *)(word + i), x);
+    }
+
+  unpack_dta_sse (p, word + i, n - i);
+}
+
+#endif /* X86_KERNELS */
+
+struct unpack_kernel
+{
+  const char *name;
+  void (*core) (const unsigned char *, word_t *, size_t);
+  void (*bin) (const unsigned char *, word_t *, size_t);
+  void (*dta) (const unsigned char *, word_t *, size_t);
+};
+
+static struct unpack_kernel kernels[] = {
+#ifdef X86_KERNELS
+  { "avx2", unpack_core_avx2, unpack_bin_avx2, unpack_dta_avx2 },
+  { "sse", unpack_core_sse, unpack_bin_sse, unpack_dta_sse },
+#endif
+  { "scalar", unpack_core_scalar, unpack_bin_scalar, unpack_dta_scalar },
+  { NULL, NULL, NULL, NULL }
+};
+
+static struct unpack_kernel *kernel = NULL;
+
+static int
+supported (const struct unpack_kernel *k)
+{
+#ifdef X86_KERNELS
+  __builtin_cpu_init ();
+  if (strcmp (k->name, "avx2") == 0)
+    return __builtin_cpu_supports ("avx2");
+  if (strcmp (k->name, "sse") == 0)
+    return __builtin_cpu_supports ("ssse3") &&
+           __builtin_cpu_supports ("sse4.1");
+#endif
+  return k->name != NULL;
+}
+
+int
+select_unpack_kernel (const char *name)
+{
+  struct unpack_kernel *k;
+
+  for (k = kernels; k->name != NULL; k++)
+    {
+      if (name != NULL && strcmp (name, k->name) != 0)
+        continue;
+      if (!supported (k))
+        continue;
+      kernel = k;
+      return 0;
+    }
+
+  return -1;
+}
+
+static struct unpack_kernel *
+get_kernel (void)
+{
+  if (kernel == NULL)
+    select_unpack_kernel (NULL);
+  return kernel;
+}
+
+void
+unpack_core (const unsigned char *p, word_t *word, size_t n)
+{
+  get_kernel ()->core (p, word, n);
+}
+
+void
+unpack_bin (const unsigned char *p, word_t *word, size_t n)
+{
+  get_kernel ()->bin (p, word, n);
+}
+
+void
+unpack_dta (const unsigned char *p, word_t *word, size_t n)
+{
+  get_kernel ()->dta (p, word, n);
+}
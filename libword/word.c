@@ -16,11 +16,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "libword.h"
 
-struct word_format *input_word_format = &its_word_format;
-struct word_format *output_word_format = &its_word_format;
+#define INITIAL_WORD_CONTEXT {					\
+  .input_format = &its_word_format,					\
+  .output_format = &its_word_format,					\
+  .aa = { .output = -1 },						\
+  .its = { .output = -1, .previous_octet = -1 },			\
+  .tape = { .bits = START_FILE, .beginning_of_tape = 1 }		\
+}
+
+static const struct word_context initial_word_context = INITIAL_WORD_CONTEXT;
+static struct word_context default_word_context = INITIAL_WORD_CONTEXT;
+
+__thread struct word_context *word_context = &default_word_context;
 
 static struct word_format *word_formats[] = {
   &aa_word_format,
@@ -38,7 +50,22 @@ static struct word_format *word_formats[] = {
   &tape7_word_format,
   NULL
 };
-static word_t checksum;
+
+void
+init_word_context (struct word_context *context)
+{
+  *context = initial_word_context;
+}
+
+void
+free_word_context (struct word_context *context)
+{
+  if (context->mapped_file != NULL)
+    munmap ((void *)context->mapped_data, context->mapped_size);
+  stop_tape_reader (context);
+  free (context->tape.record);
+  init_word_context (context);
+}
 
 void
 usage_word_format (void)
@@ -69,106 +96,306 @@ parse_word_format (const char *string, struct word_format **word_format)
 int
 parse_input_word_format (const char *string)
 {
-  return parse_word_format (string, &input_word_format);
+  return parse_word_format (string, &word_context->input_format);
 }
 
 int
 parse_output_word_format (const char *string)
 {
-  return parse_word_format (string, &output_word_format);
+  return parse_word_format (string, &word_context->output_format);
 }
 
 word_t
 get_word (FILE *f)
 {
-  if (input_word_format->get_word == NULL)
+  if (word_context->input_format->get_word == NULL)
     {
-      fprintf (stderr, "word format \"%s\" not supported for input\n", input_word_format->name);
+      fprintf (stderr, "word format \"%s\" not supported for input\n", word_context->input_format->name);
       exit (1);
     }
-  return input_word_format->get_word (f);
+  return word_context->input_format->get_word (f);
+}
+
+size_t
+get_words (FILE *f, word_t *buffer, size_t n)
+{
+  size_t i;
+
+  if (word_context->input_format->get_words != NULL)
+    return word_context->input_format->get_words (f, buffer, n);
+
+  for (i = 0; i < n; i++)
+    {
+      if ((buffer[i] = get_word (f)) == -1)
+        break;
+    }
+
+  return i;
 }
 
 void
 rewind_word (FILE *f)
 {
-  if (input_word_format->rewind_word == NULL)
+  if (word_context->input_format->rewind_word == NULL)
     {
-      rewind (f);
+      rewind_octet (f);
       return;
     }
 
-  input_word_format->rewind_word (f);
+  word_context->input_format->rewind_word (f);
 }
 
 void
 seek_word (FILE *f, int position)
 {
-  if (input_word_format->seek_word == NULL)
+  if (word_context->input_format->seek_word == NULL)
     {
-      input_word_format->rewind_word (f);
+      rewind_word (f);
       while (position-- > 0)
         get_word (f);
       return;
     }
 
-  input_word_format->rewind_word (f);
+  word_context->input_format->seek_word (f, position);
 }
 
 void
 by_five_octets (FILE *f, int position)
 {
-  input_word_format->rewind_word (f);
-  fseek (f, 5 * position, SEEK_SET);
+  rewind_word (f);
+  seek_octet (f, 5L * position);
 }
 
 void
 by_eight_octets (FILE *f, int position)
 {
-  input_word_format->rewind_word (f);
-  fseek (f, 8 * position, SEEK_SET);
+  rewind_word (f);
+  seek_octet (f, 8L * position);
 }
 
 void
 write_word (FILE *f, word_t word)
 {
-  if (output_word_format->write_word == NULL)
+  if (word_context->output_format->write_word == NULL)
     {
-      fprintf (stderr, "word format \"%s\" not supported for output\n", output_word_format->name);
+      fprintf (stderr, "word format \"%s\" not supported for output\n", word_context->output_format->name);
       exit (1);
     }
-  output_word_format->write_word (f, word);
+  word_context->output_format->write_word (f, word);
 }
 
 void
 flush_word (FILE *f)
 {
-  if (output_word_format->flush_word == NULL)
+  if (word_context->output_format->flush_word == NULL)
     return;
 
-  output_word_format->flush_word (f);
+  word_context->output_format->flush_word (f);
 }
 
 void
 reset_checksum (word_t word)
 {
-  checksum = word;
+  word_context->checksum = word;
 }
 
 void
 check_checksum (word_t word)
 {
-  if (word != checksum)
-    printf ("  [WARNING: bad checksum, %012llo /= %012llo]\n", word, checksum);
+  if (word != word_context->checksum)
+    printf ("  [WARNING: bad checksum, %012llo /= %012llo]\n",
+	    word, word_context->checksum);
 }
 
 word_t
 get_checksummed_word (FILE *f)
 {
+  struct word_context *c = word_context;
   word_t word = get_word (f);
 
-  checksum = (checksum << 1) + (checksum >> 35) + word;
-  checksum &= 0777777777777ULL;
+  c->checksum = (c->checksum << 1) + (c->checksum >> 35) + word;
+  c->checksum &= 0777777777777ULL;
 
   return word;
 }
+
+/* Like calling get_checksummed_word n times. */
+void
+get_checksummed_words (FILE *f, word_t *buffer, size_t n)
+{
+  struct word_context *c = word_context;
+  size_t i;
+
+  for (i = get_words (f, buffer, n); i < n; i++)
+    buffer[i] = get_word (f);
+
+  for (i = 0; i < n; i++)
+    {
+      c->checksum = (c->checksum << 1) + (c->checksum >> 35) + buffer[i];
+      c->checksum &= 0777777777777ULL;
+    }
+}
+
+/* While a file is mapped, the word formats read octets from the
+   mapping instead of through stdio. */
+int
+map_word_input (FILE *f)
+{
+  struct word_context *c = word_context;
+  struct stat st;
+  void *data;
+  long position;
+
+  if (c->mapped_file != NULL)
+    unmap_word_input (c->mapped_file);
+
+  position = ftell (f);
+  if (position < 0 || fstat (fileno (f), &st) == -1 ||
+      !S_ISREG (st.st_mode) || st.st_size == 0)
+    return -1;
+
+  data = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno (f), 0);
+  if (data == MAP_FAILED)
+    return -1;
+  madvise (data, st.st_size, MADV_SEQUENTIAL);
+
+  c->mapped_file = f;
+  c->mapped_data = data;
+  c->mapped_size = st.st_size;
+  c->mapped_position = position;
+  c->mapped_eof = 0;
+  return 0;
+}
+
+void
+unmap_word_input (FILE *f)
+{
+  struct word_context *c = word_context;
+
+  if (f != c->mapped_file)
+    return;
+
+  munmap ((void *)c->mapped_data, c->mapped_size);
+  c->mapped_file = NULL;
+  fseek (f, c->mapped_position, SEEK_SET);
+  if (c->mapped_eof)
+    fgetc (f);
+}
+
+int
+get_octet (FILE *f)
+{
+  struct word_context *c = word_context;
+
+  if (f != c->mapped_file)
+    return getc_unlocked (f);
+
+  if (c->mapped_position >= c->mapped_size)
+    {
+      c->mapped_eof = 1;
+      return EOF;
+    }
+
+  return c->mapped_data[c->mapped_position++];
+}
+
+const unsigned char *
+get_octets (FILE *f, size_t n)
+{
+  struct word_context *c = word_context;
+  const unsigned char *p;
+
+  if (f != c->mapped_file || c->mapped_size - c->mapped_position < n ||
+      c->mapped_position > c->mapped_size)
+    return NULL;
+
+  p = c->mapped_data + c->mapped_position;
+  c->mapped_position += n;
+  return p;
+}
+
+/* Return a pointer to the next n octets and advance past them, but
+   only if all of them are available.  Otherwise return NULL and leave
+   the input alone.  The buffer is used when reading through stdio. */
+const unsigned char *
+get_octet_block (FILE *f, unsigned char *buffer, size_t n)
+{
+  struct stat st;
+  long position;
+
+  if (f == word_context->mapped_file)
+    return get_octets (f, n);
+
+  if (feof (f))
+    return NULL;
+  position = ftell (f);
+  if (position < 0 || fstat (fileno (f), &st) == -1 ||
+      !S_ISREG (st.st_mode) || st.st_size - position < (off_t)n)
+    return NULL;
+
+  if (fread (buffer, 1, n, f) != n)
+    {
+      fprintf (stderr, "Error reading input.\n");
+      exit (1);
+    }
+
+  return buffer;
+}
+
+/* Undo getting the last n octets from get_octet_block. */
+void
+unget_octet_block (FILE *f, size_t n)
+{
+  if (f == word_context->mapped_file)
+    word_context->mapped_position -= n;
+  else
+    fseek (f, -(long)n, SEEK_CUR);
+}
+
+int
+eof_octet (FILE *f)
+{
+  if (f != word_context->mapped_file)
+    return feof (f);
+
+  return word_context->mapped_eof;
+}
+
+void
+rewind_octet (FILE *f)
+{
+  struct word_context *c = word_context;
+
+  if (f != c->mapped_file)
+    {
+      rewind (f);
+      return;
+    }
+
+  c->mapped_position = 0;
+  c->mapped_eof = 0;
+}
+
+long
+tell_octet (FILE *f)
+{
+  if (f != word_context->mapped_file)
+    return ftell (f);
+
+  return word_context->mapped_position;
+}
+
+void
+seek_octet (FILE *f, long position)
+{
+  struct word_context *c = word_context;
+
+  if (f != c->mapped_file)
+    {
+      fseek (f, position, SEEK_SET);
+      return;
+    }
+
+  c->mapped_position = position;
+  c->mapped_eof = 0;
+}
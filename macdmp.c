@@ -420,8 +420,8 @@ main (int argc, char **argv)
   int opt;
 
   image_file = NULL;
-  input_word_format = &dta_word_format;
-  output_word_format = &its_word_format;
+  word_context->input_format = &dta_word_format;
+  word_context->output_format = &its_word_format;
   verbose = 0;
 
   while ((opt = getopt (argc, argv, "vc:t:x:W:N:")) != -1)
@@ -475,9 +475,9 @@ main (int argc, char **argv)
 
   if (create)
     {
-      struct word_format *tmp = input_word_format;
-      input_word_format = output_word_format;
-      output_word_format = tmp;
+      struct word_format *tmp = word_context->input_format;
+      word_context->input_format = word_context->output_format;
+      word_context->output_format = tmp;
 
       memset (image, 0, sizeof image);
       memset (block_area, 0, sizeof block_area);
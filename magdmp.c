@@ -32,7 +32,7 @@ main (int argc, char **argv)
       exit (1);
     }
 
-  output_file = stdout;
+  file_context->output = stdout;
   f = fopen (argv[1], "rb");
 
   for (;;)
@@ -169,8 +169,8 @@ main (int argc, char **argv)
 {
   int i = 1;
 
-  input_word_format = &its_word_format;
-  output_file = stdout;
+  word_context->input_format = &its_word_format;
+  file_context->output = stdout;
 
   /* Default to 9-track tape. */
   nine_tracks ();
@@ -16,11 +16,16 @@
 #include <stdio.h>
 #include <errno.h>
 #include <string.h>
+#include <stdlib.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 
 #include "dis.h"
 #include "opcode/pdp10.h"
 #include "memory.h"
+#include "symbols.h"
+#include "mkdirs.h"
 
 static void
 tape_special (int code)
@@ -28,13 +33,13 @@ tape_special (int code)
   switch ((code >> 24) & 0xFF)
     {
     case 0x80:
-      fprintf (output_file, "Tape error %06x.\n", code & 0xFFFFFF);
+      fprintf (file_context->output, "Tape error %06x.\n", code & 0xFFFFFF);
       break;
     case 0xFF:
-      fprintf (output_file, "Tape gap (%06x).\n", code & 0xFFFFFF);
+      fprintf (file_context->output, "Tape gap (%06x).\n", code & 0xFFFFFF);
       break;
     default:
-      fprintf (output_file, "Tape special (%08x).\n", code);
+      fprintf (file_context->output, "Tape special (%08x).\n", code);
       break;
     }
 }
@@ -42,7 +47,7 @@ tape_special (int code)
 static void
 usage (char **argv)
 {
-  fprintf (stderr, "Usage: %s [-6] [-r] [-F<file format>] [-S<symbol mode>] [-W<word format>] [-D<DDT address>] <file>\n\n", argv[0]);
+  fprintf (stderr, "Usage: %s [-6] [-r] [-c] [-P] [-F<file format>] [-S<symbol mode>] [-W<word format>] [-D<DDT address>] [-j threads] [-J] [-C cache directory] [-o output directory] [-l list file] [-X xref file] <file...>\n\n", argv[0]);
   usage_file_format ();
   usage_word_format ();
   usage_symbols_mode ();
@@ -50,32 +55,308 @@ usage (char **argv)
   exit (1);
 }
 
-int
-main (int argc, char **argv)
+static struct file_format *file_format = NULL;
+static int cpu_model = PDP10_KA10_ITS;
+static int ddt = 0;
+static const char *cache = NULL;
+static const char *xref = NULL;
+static int profiling = 0;
+
+/* Load a file and write the disassembly to out.  Information about
+   the file goes to info.  If xref_name is "-", the cross references
+   are added to the output. */
+static int
+disassemble_file (const char *name, FILE *out, FILE *info,
+		  const char *xref_name)
 {
-  int cpu_model = PDP10_KA10_ITS;
   struct pdp10_memory memory;
+  struct loaded_file loaded;
+  unsigned long long key = 0;
+  char options[100];
   FILE *file;
-  word_t word, data;
-  int opt;
-  int ddt = 0;
-  int extra;
+  word_t word;
+
+  file = fopen (name, "rb");
+  if (file == NULL)
+    {
+      fprintf (stderr, "Error opening %s: %s\n", name, strerror (errno));
+      return 1;
+    }
+  rewind_word (file);
+
+  file_context->output = info;
+  file_context->input_format = file_format;
+  file_context->start_instruction = 0;
+  file_context->entry_points = 0;
+  init_memory (&memory);
+
+  if (cache != NULL)
+    {
+      snprintf (options, sizeof options, "%s %s %x",
+		file_context->input_format
+		? file_context->input_format->name : "guess",
+		word_context->input_format->name, cpu_model);
+      key = cache_key (file, options);
+    }
+
+  if (cache == NULL || read_cache (cache, key, &memory, &loaded) != 0)
+    {
+      /* Keep the text printed by the loader for the cache. */
+      if (cache != NULL)
+	file_context->output = open_memstream (&loaded.text,
+					       &loaded.text_length);
+
+      if (!file_context->input_format)
+	guess_input_file_format (file);
+      file_context->input_format->read (file, &memory, cpu_model);
+
+      loaded.extra = 0;
+      while ((word = get_word (file)) != -1)
+	{
+	  loaded.extra_data = word;
+	  loaded.extra++;
+	}
+
+      if (cache != NULL)
+	{
+	  fclose (file_context->output);
+	  file_context->output = info;
+	  write_cache (cache, key, &memory, &loaded);
+	}
+    }
+  fclose (file);
+
+  if (cache != NULL)
+    {
+      fwrite (loaded.text, 1, loaded.text_length, file_context->output);
+      free (loaded.text);
+    }
+
+  if (loaded.extra == 1)
+    fprintf (file_context->output,
+	     "(After parsed data, there was one more word: %012llo)\n",
+	     loaded.extra_data);
+  else if (loaded.extra > 1)
+    fprintf (file_context->output,
+	     "(After parsed data, there were %d more words.)\n", loaded.extra);
+
+  if (ddt)
+    ntsddt_info (&memory, ddt);
 
-  output_file = stdout;
+  if (dis_format == DIS_JSON)
+    file_context->output = out;
+  else
+    fprintf (file_context->output,
+	     profiling ? "\nProfile:\n\n" : "\nDisassembly:\n\n");
+  if (profiling)
+    profile (&memory, cpu_model);
+  else
+    dis (&memory, cpu_model);
+  fflush (file_context->output);
 
-  while ((opt = getopt (argc, argv, "6rF:S:W:m:D:")) != -1)
+  if (xref_name != NULL)
+    {
+      if (strcmp (xref_name, "-") == 0)
+	write_xref (file_context->output);
+      else
+	{
+	  file = fopen (xref_name, "w");
+	  if (file == NULL)
+	    {
+	      fprintf (stderr, "Error writing %s: %s\n",
+		       xref_name, strerror (errno));
+	      exit (1);
+	    }
+	  write_xref (file);
+	  fclose (file);
+	}
+      fflush (file_context->output);
+    }
+
+  free_memory (&memory);
+  free_symbols ();
+  return 0;
+}
+
+/* In batch mode, the listing for an input file goes to the same path
+   under the output directory, with a suffix added.  Some loaders print
+   to stdout, so that is where the listing is written. */
+static int
+batch_file (const char *name, const char *dir)
+{
+  char path[1000], xref_path[1000];
+  const char *p, *xref_name = xref;
+  int status;
+
+  for (p = name; *p == '/'; p++)
+    ;
+  while (strncmp (p, "./", 2) == 0)
+    p += 2;
+  if (strcmp (p, "..") == 0 || strncmp (p, "../", 3) == 0 ||
+      strstr (p, "/../") != NULL)
+    {
+      fprintf (stderr, "Not writing %s outside %s.\n", name, dir);
+      return 1;
+    }
+
+  snprintf (path, sizeof path, "%s/%s%s", dir, p,
+	    dis_format == DIS_JSON ? ".jsonl" : ".dasm");
+  mkdirs (path);
+  if (freopen (path, "w", stdout) == NULL)
+    {
+      fprintf (stderr, "Error writing %s: %s\n", path, strerror (errno));
+      return 1;
+    }
+
+  /* Cross references go next to the listing. */
+  if (xref_name != NULL && strcmp (xref_name, "-") != 0)
+    {
+      snprintf (xref_path, sizeof xref_path, "%s/%s.xref", dir, p);
+      xref_name = xref_path;
+    }
+
+  status = disassemble_file (name, stdout,
+			     dis_format == DIS_JSON ? stderr : stdout,
+			     xref_name);
+  if (fflush (stdout) != 0 || ferror (stdout))
+    {
+      fprintf (stderr, "Error writing %s: %s\n", path, strerror (errno));
+      return 1;
+    }
+  return status;
+}
+
+static void
+add_name (char ***names, int *n, int *size, char *name)
+{
+  if (*n == *size)
+    {
+      *size = *size ? 2 * *size : 64;
+      *names = realloc (*names, *size * sizeof **names);
+      if (*names == NULL)
+	{
+	  fprintf (stderr, "Out of memory.\n");
+	  exit (1);
+	}
+    }
+  (*names)[(*n)++] = name;
+}
+
+static void
+read_list (const char *list, char ***names, int *n, int *size)
+{
+  char *line = NULL;
+  size_t length = 0;
+  ssize_t m;
+  FILE *f;
+
+  f = strcmp (list, "-") == 0 ? stdin : fopen (list, "r");
+  if (f == NULL)
+    {
+      fprintf (stderr, "Error opening %s: %s\n", list, strerror (errno));
+      exit (1);
+    }
+
+  while ((m = getline (&line, &length, f)) != -1)
+    {
+      if (m > 0 && line[m - 1] == '\n')
+	line[--m] = 0;
+      if (m == 0)
+	continue;
+      add_name (names, n, size, strdup (line));
+    }
+
+  free (line);
+  if (f != stdin)
+    fclose (f);
+}
+
+/* Each worker is a process which takes files off a shared counter
+   until there are none left.  The loaders exit on bad input, so a
+   worker which dies is replaced and only its current file is lost. */
+static int
+batch (char **names, int n, const char *dir, int workers)
+{
+  int *next, status, running = 0, failed = 0;
+  int i;
+
+  if (workers > n)
+    workers = n;
+
+  next = mmap (NULL, sizeof *next, PROT_READ | PROT_WRITE,
+	       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (next == MAP_FAILED)
+    {
+      fprintf (stderr, "Error creating shared counter.\n");
+      exit (1);
+    }
+  *next = 0;
+
+  for (;;)
+    {
+      while (running < workers && __atomic_load_n (next, __ATOMIC_SEQ_CST) < n)
+	{
+	  fflush (stdout);
+	  fflush (stderr);
+	  switch (fork ())
+	    {
+	    case -1:
+	      fprintf (stderr, "Error creating worker: %s\n", strerror (errno));
+	      exit (1);
+	    case 0:
+	      status = 0;
+	      while ((i = __atomic_fetch_add (next, 1, __ATOMIC_SEQ_CST)) < n)
+		status |= batch_file (names[i], dir);
+	      exit (status);
+	    default:
+	      running++;
+	      break;
+	    }
+	}
+
+      if (running == 0)
+	break;
+      if (wait (&status) == -1)
+	break;
+      running--;
+      if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+	failed = 1;
+    }
+
+  munmap (next, sizeof *next);
+  return failed;
+}
+
+int
+main (int argc, char **argv)
+{
+  const char *dir = NULL, *list = NULL;
+  char **names = NULL;
+  int n = 0, size = 0;
+  int opt, i;
+
+  file_context->output = stdout;
+
+  while ((opt = getopt (argc, argv, "6rcPF:S:W:m:D:j:JC:o:l:X:")) != -1)
     {
       switch (opt)
 	{
 	case '6':
-	  input_file_format = &dmp_file_format;
+	  file_format = &dmp_file_format;
 	  break;
 	case 'r':
-	  input_file_format = &raw_file_format;
+	  file_format = &raw_file_format;
+	  break;
+	case 'c':
+	  dis_code = 1;
+	  break;
+	case 'P':
+	  profiling = 1;
 	  break;
 	case 'F':
 	  if (parse_input_file_format (optarg))
 	    usage (argv);
+	  file_format = file_context->input_format;
 	  break;
 	case 'm':
 	  if (parse_machine (optarg, &cpu_model))
@@ -92,47 +373,51 @@ main (int argc, char **argv)
 	case 'D':
 	  ddt = strtol (optarg, NULL, 8);
 	  break;
+	case 'j':
+	  dis_threads = atoi (optarg);
+	  if (dis_threads < 1)
+	    usage (argv);
+	  break;
+	case 'J':
+	  dis_format = DIS_JSON;
+	  break;
+	case 'C':
+	  cache = optarg;
+	  break;
+	case 'o':
+	  dir = optarg;
+	  break;
+	case 'l':
+	  list = optarg;
+	  break;
+	case 'X':
+	  xref = optarg;
+	  dis_xref = 1;
+	  break;
 	default:
 	  usage (argv);
 	}
     }
 
-  if (optind != argc - 1)
-    usage (argv);
+  word_context->tape_hook = tape_special;
 
-  file = fopen (argv[optind], "rb");
-  if (file == NULL)
+  if (dir == NULL)
     {
-      fprintf (stderr, "%s: Error opening %s: %s\n",
-	       argv[0], argv[optind], strerror (errno));
-      return 1;
-    }
-
-  init_memory (&memory);
-
-  tape_hook = tape_special;
-
-  if (!input_file_format)
-    guess_input_file_format (file);
-  input_file_format->read (file, &memory, cpu_model);
-
-  extra = 0;
-  while ((word = get_word (file)) != -1)
-    {
-      data = word;
-      extra++;
+      if (list != NULL || optind != argc - 1)
+	usage (argv);
+      /* With JSON Lines output, only the disassembly goes to stdout. */
+      return disassemble_file (argv[optind], stdout,
+			       dis_format == DIS_JSON ? stderr : stdout, xref);
     }
-  if (extra == 1)
-    printf ("(After parsed data, there was one more word: %012llo)\n",
-	    data);
-  else if (extra > 1)
-    printf ("(After parsed data, there were %d more words.)\n", extra);
-
-  if (ddt)
-    ntsddt_info (&memory, ddt);
 
-  printf ("\nDisassembly:\n\n");
-  dis (&memory, cpu_model);
-
-  return 0;
+  /* In batch mode, -j is the number of files processed at once. */
+  for (i = optind; i < argc; i++)
+    add_name (&names, &n, &size, argv[i]);
+  if (list != NULL)
+    read_list (list, &names, &n, &size);
+  if (n == 0)
+    usage (argv);
+  i = dis_threads;
+  dis_threads = 1;
+  return batch (names, n, dir, i);
 }
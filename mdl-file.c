@@ -47,7 +47,7 @@ strip_spaces (char *string)
 static void
 add_global (const char *name, word_t value)
 {
-  fprintf (output_file, "    Symbol %-6s = %llo\n", name, value);
+  fprintf (file_context->output, "    Symbol %-6s = %llo\n", name, value);
 
   add_symbol (name, value, SYMBOL_GLOBAL);
 }
@@ -161,17 +161,17 @@ read_mdl (FILE *f, struct pdp10_memory *memory, int cpu_model)
   word_t partop_v, purtop_v, hibot, pmapb;
   int i;
 
-  fprintf (output_file, "Muddle save format\n\n");
+  fprintf (file_context->output, "Muddle save format\n\n");
 
   word_to_ascii7 (get_word (f), version);
   strip_spaces (version);
-  fprintf (output_file, "Muddle version: \"%s\"\n\n", version);
+  fprintf (file_context->output, "Muddle version: \"%s\"\n\n", version);
 
-  fprintf (output_file, "Interpreter symbols:\n");
+  fprintf (file_context->output, "Interpreter symbols:\n");
   define_mdl_symbols (version);
 
   word = get_word (f);
-  fprintf (output_file, "\nValue of p.top  = %llo\n", word);
+  fprintf (file_context->output, "\nValue of p.top  = %llo\n", word);
 
   word = get_word (f);
   if (word != 0)
@@ -180,13 +180,13 @@ read_mdl (FILE *f, struct pdp10_memory *memory, int cpu_model)
       fprintf (stderr, "Muddle slow save format not supported\n");
       exit (1);
     }
-  fprintf (output_file, "Fast save format\n");
+  fprintf (file_context->output, "Fast save format\n");
 
   word = get_word (f);
-  fprintf (output_file, "Value of vectop = %llo\n", word);
+  fprintf (file_context->output, "Value of vectop = %llo\n", word);
 
   partop_v = get_word (f);
-  fprintf (output_file, "Value of partop = %llo\n", partop_v);
+  fprintf (file_context->output, "Value of partop = %llo\n", partop_v);
 
   /* Impure memory, from location 5 to partop. */
   load_to_memory (f, memory, 5, partop_v - 5, "impure memory");
@@ -198,7 +198,7 @@ read_mdl (FILE *f, struct pdp10_memory *memory, int cpu_model)
   /* Pure memory in the page map. Only pages that are marked in the
      page map as purified are written out. The page map has two bits
      per page. */
-  fprintf (output_file, "\nPage map:\n");
+  fprintf (file_context->output, "\nPage map:\n");
   for (i = purtop_v / MDL_PAGESIZE; i < (hibot / MDL_PAGESIZE); i++)
     {
       word_t entry, mask;
@@ -207,7 +207,7 @@ read_mdl (FILE *f, struct pdp10_memory *memory, int cpu_model)
       entry = get_word_at (memory, pmapb + (i / 16));
       mask = (1ll << 35) >> ((2 * (i % 16)) + 1);
       purified = (entry & mask) != 0;
-      fprintf (output_file, "Page %03o: %s\n", i, purified ? "pure" : "not pure");
+      fprintf (file_context->output, "Page %03o: %s\n", i, purified ? "pure" : "not pure");
 
       if (purified)
 	{
@@ -216,7 +216,7 @@ read_mdl (FILE *f, struct pdp10_memory *memory, int cpu_model)
 	}
     }
 
-  fprintf (output_file, "\n");
+  fprintf (file_context->output, "\n");
 }
 
 struct file_format mdl_file_format = {
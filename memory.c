@@ -18,56 +18,208 @@
 #include <string.h>
 #include "memory.h"
 
+/* Memory contents are kept in a two-level page table: a section
+   table indexed by the high bits of the address, pointing to page
+   tables indexed by the middle bits.  Each page records which of its
+   words are present.  The areas are kept separately, sorted by
+   address, and describe the runs of memory which were loaded. */
+
+#define PAGE_INDEX(address) (((address) >> MEMORY_PAGE_BITS) & \
+			     (MEMORY_SECTION_PAGES - 1))
+#define SECTION_INDEX(address) ((address) >> MEMORY_SECTION_BITS)
+#define WORD_INDEX(address) ((address) & (MEMORY_PAGESIZE - 1))
+
 #define IMPURE(area) (((area)->flags & MEMORY_PURE) == 0)
 
-static struct pdp10_area *
-find_area (struct pdp10_memory *memory, int address)
+static void *
+xcalloc (size_t n, size_t size)
+{
+  void *p = calloc (n, size);
+  if (p == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  return p;
+}
+
+static int
+valid_address (int address)
 {
-  int i, j, k;
+  return address >= 0 && address < (1 << MEMORY_ADDRESS_BITS);
+}
 
-  if (memory->areas == 0)
+/* Return the page holding an address, or NULL. */
+static struct pdp10_page *
+find_page (struct pdp10_memory *memory, int address)
+{
+  struct pdp10_page **section;
+
+  if (memory->section == NULL || !valid_address (address))
+    return NULL;
+  section = memory->section[SECTION_INDEX (address)];
+  if (section == NULL)
     return NULL;
+  return section[PAGE_INDEX (address)];
+}
+
+/* Return the page holding an address, creating it if needed. */
+static struct pdp10_page *
+make_page (struct pdp10_memory *memory, int address)
+{
+  struct pdp10_page ***section, **page;
 
-  i = 0;
-  j = memory->areas - 1;
+  if (!valid_address (address))
+    {
+      fprintf (stderr, "Address %o out of range.\n", address);
+      exit (1);
+    }
+
+  if (memory->section == NULL)
+    memory->section = xcalloc (MEMORY_SECTIONS, sizeof *memory->section);
+  section = &memory->section[SECTION_INDEX (address)];
+  if (*section == NULL)
+    *section = xcalloc (MEMORY_SECTION_PAGES, sizeof **section);
+  page = &(*section)[PAGE_INDEX (address)];
+  if (*page == NULL)
+    *page = xcalloc (1, sizeof **page);
+  return *page;
+}
+
+static int
+present (struct pdp10_page *page, int address)
+{
+  int i = WORD_INDEX (address);
+  return page != NULL && (page->present[i / 64] >> (i % 64)) & 1;
+}
+
+/* Copy words into the pages, and mark them present. */
+static void
+store_words (struct pdp10_memory *memory, int address, int length,
+	     const word_t *data)
+{
+  struct pdp10_page *page;
+  int i, n;
+
+  while (length > 0)
+    {
+      page = make_page (memory, address);
+      i = WORD_INDEX (address);
+      n = MEMORY_PAGESIZE - i;
+      if (n > length)
+	n = length;
+      memcpy (&page->data[i], data, n * sizeof *data);
+      memory->generation++;
+      address += n;
+      data += n;
+      length -= n;
+      for (; n > 0; n--, i++)
+	page->present[i / 64] |= 1ULL << (i % 64);
+    }
+}
+
+/* Mark a range of addresses as not present. */
+static void
+clear_words (struct pdp10_memory *memory, int address, int end)
+{
+  struct pdp10_page *page;
+  int i;
 
-  while (i <= j)
+  memory->generation++;
+  for (; address < end; address++)
     {
-      k = (i + j) / 2;
+      page = find_page (memory, address);
+      if (page == NULL)
+	continue;
+      i = WORD_INDEX (address);
+      page->present[i / 64] &= ~(1ULL << (i % 64));
+    }
+}
 
-      if (address < memory->area[k].start)
-	j = k - 1;
-      else if (address >= memory->area[k].end)
+/* Return the index of the first area starting at or after an
+   address. */
+static int
+area_index (struct pdp10_memory *memory, int address)
+{
+  int i = 0, j = memory->areas;
+
+  while (i < j)
+    {
+      int k = (i + j) / 2;
+      if (memory->area[k].start < address)
 	i = k + 1;
       else
-	return &memory->area[k];
+	j = k;
     }
 
-  return NULL;
+  return i;
+}
+
+static struct pdp10_area *
+find_area (struct pdp10_memory *memory, int address)
+{
+  int i = area_index (memory, address + 1) - 1;
+
+  if (i < 0 || address >= memory->area[i].end)
+    return NULL;
+  return &memory->area[i];
 }
 
 void
 init_memory (struct pdp10_memory *memory)
 {
   memory->areas = 0;
+  memory->allocated = 0;
   memory->area = NULL;
   memory->current_area = NULL;
   memory->current_address = 0;
+  memory->section = NULL;
+  memory->generation = 1;
+}
+
+void
+free_memory (struct pdp10_memory *memory)
+{
+  int i, j;
+
+  if (memory->section != NULL)
+    {
+      for (i = 0; i < MEMORY_SECTIONS; i++)
+	{
+	  if (memory->section[i] == NULL)
+	    continue;
+	  for (j = 0; j < MEMORY_SECTION_PAGES; j++)
+	    {
+	      if (memory->section[i][j] != NULL)
+		free (memory->section[i][j]->indirect);
+	      free (memory->section[i][j]);
+	    }
+	  free (memory->section[i]);
+	}
+      free (memory->section);
+    }
+  free (memory->area);
+  init_memory (memory);
 }
 
 static struct pdp10_area *
 insert_area (struct pdp10_memory *memory, int i)
 {
-  memory->areas++;
-  memory->area = realloc (memory->area, memory->areas * sizeof (struct pdp10_area));
-  if (memory->area == NULL)
+  if (memory->areas == memory->allocated)
     {
-      fprintf (stderr, "realloc failed\n");
-      exit (1);
+      memory->allocated = memory->allocated ? 2 * memory->allocated : 16;
+      memory->area = realloc (memory->area,
+			      memory->allocated * sizeof (struct pdp10_area));
+      if (memory->area == NULL)
+	{
+	  fprintf (stderr, "realloc failed\n");
+	  exit (1);
+	}
     }
 
   memmove (&memory->area[i+1], &memory->area[i],
-	   (memory->areas - i - 1) * sizeof (struct pdp10_area));
+	   (memory->areas - i) * sizeof (struct pdp10_area));
+  memory->areas++;
   return &memory->area[i];
 }
 
@@ -77,30 +229,21 @@ add_memory (struct pdp10_memory *memory, int address, int length, word_t *data)
   struct pdp10_area *area;
   int i;
 
-  if (find_area (memory, address) != NULL)
+  if (present (find_page (memory, address), address))
     return -2;
 
-  for (i = 0; i < memory->areas; i++)
-    {
-      if (address > memory->area[i].start)
-	continue;
-      break;
-    }
+  store_words (memory, address, length, data);
+  free (data);
+
+  /* Most loaders add memory in ascending order. */
+  if (memory->areas > 0 && address > memory->area[memory->areas - 1].start)
+    i = memory->areas;
+  else
+    i = area_index (memory, address);
 
   if (i > 0 && address == memory->area[i-1].end && IMPURE(&memory->area[i-1]))
     {
-      int new_length;
-      area = &memory->area[i-1];
-      new_length = length + area->end - area->start;
-      area->data = realloc (area->data, new_length * sizeof (word_t));
-      if (area->data == NULL)
-	{
-	  fprintf (stderr, "realloc failed\n");
-	  exit (1);
-	}
-      memcpy (&area->data[area->end - area->start], data, sizeof (word_t) * length);
-      area->end += length;
-      free (data);
+      memory->area[i-1].end += length;
       return 0;
     }
 
@@ -108,7 +251,6 @@ add_memory (struct pdp10_memory *memory, int address, int length, word_t *data)
   area->start = address;
   area->end = address + length;
   area->flags = 0;
-  area->data = data;
 
   return 0;
 }
@@ -116,7 +258,6 @@ add_memory (struct pdp10_memory *memory, int address, int length, word_t *data)
 static void
 remove_area (struct pdp10_memory *memory, int i)
 {
-  free (memory->area[i].data);  
   memmove (&memory->area[i], &memory->area[i+1],
 	   (memory->areas - i - 1) * sizeof (struct pdp10_area));
   memory->areas--;
@@ -133,20 +274,25 @@ remove_memory (struct pdp10_memory *memory, int address, int length)
     {
       area = &memory->area[i];
       if (area->start >= address && area->end <= end)
-	/* The area is entirely within the range, so remove it completely */
-	remove_area (memory, i);
+	{
+	  /* The area is entirely within the range, so remove it completely */
+	  clear_words (memory, area->start, area->end);
+	  remove_area (memory, i);
+	}
       else if (area->end <= address || area->start >= end)
 	/* The area is entirely outside the range; leave it alone. */
 	i++;
       else if (area->start < address)
 	{
 	  /* The area is partly inside the range; remove last part. */
+	  clear_words (memory, address, area->end);
 	  area->end = address;
 	  i++;
 	}
       else if (area->end > end)
 	{
 	  /* The area is partly inside the range; remove first part. */
+	  clear_words (memory, area->start, end);
 	  area->start = end;
 	  i++;
 	}
@@ -163,8 +309,8 @@ void
 purify_memory (struct pdp10_memory *memory, int address, int length)
 {
   struct pdp10_area *area;
-  word_t *data;
-  int i, end;
+  struct pdp10_page *page;
+  int i, j, end;
 
   end = address + length;
   for (i = address; i < end; i = area->end)
@@ -175,41 +321,30 @@ purify_memory (struct pdp10_memory *memory, int address, int length)
       if (!IMPURE (area)) /* Is the area already pure? */
 	continue;
 
+      j = area - memory->area;
       if (area->start < i)
 	{
 	  /* Impure area needs to split off first part. */
-	  area = insert_area (memory, area - memory->area);
+	  area = insert_area (memory, j);
 	  area->end = i;
-	  data = area->data + area->end - area->start;
-
-	  /* New pure area. */
 	  area++;
 	  area->start = i;
-	  area->flags |= MEMORY_PURE;
-	  length = area->end - area->start;
-	  area->data = malloc (length * sizeof (word_t));
-	  memcpy (area->data, data, length);
 	}
       if (area->end > end)
 	{
 	  /* Impure area needs to split off last part. */
 	  area = insert_area (memory, area - memory->area);
-	  area->end = i;
-	  area->flags |= MEMORY_PURE;
-
-	  /* New impure area. */
-	  area++;
-	  area->start = end;
-	  length = area->end - area->start;
-	  area->data = malloc (length * sizeof (word_t));
-	  area->flags = 0;
-	  memcpy (area->data, area[-1].data + area[-1].end - area[-1].start,
-		  length);
+	  area->end = end;
+	  area[1].start = end;
 	}
-      else
+      area->flags |= MEMORY_PURE;
+
+      for (j = area->start & ~(MEMORY_PAGESIZE - 1); j < area->end;
+	   j += MEMORY_PAGESIZE)
 	{
-	  /* Whole area is inside the pure range. */
-	  area->flags |= MEMORY_PURE;
+	  page = find_page (memory, j);
+	  if (page != NULL)
+	    page->flags |= MEMORY_PURE;
 	}
     }
 }
@@ -242,12 +377,6 @@ get_address (struct pdp10_memory *memory)
   return memory->current_address;
 }
 
-static word_t
-getword (struct pdp10_area *area, int address)
-{
-  return area->data[address - area->start];
-}
-
 word_t
 get_next_word (struct pdp10_memory *memory)
 {
@@ -271,51 +400,132 @@ get_next_word (struct pdp10_memory *memory)
 	}
     }
 
-  return getword (memory->current_area, memory->current_address);
+  return get_word_at (memory, memory->current_address);
 }
 
 word_t
 get_word_at (struct pdp10_memory *memory, int address)
 {
-  struct pdp10_area *area;
+  struct pdp10_page *page;
 
-  area = find_area (memory, address);
-  if (area == NULL)
+  page = find_page (memory, address);
+  if (!present (page, address))
     return -1;
 
-  return getword (area, address);
-}
-
-static void
-setword (struct pdp10_area *area, int address, word_t word)
-{
-  area->data[address - area->start] = word;
+  return page->data[WORD_INDEX (address)];
 }
 
 void
 set_word_at (struct pdp10_memory *memory, int address, word_t word)
 {
-  struct pdp10_area *area;
+  struct pdp10_page *page;
 
-  area = find_area (memory, address);
-  if (area == NULL) {
+  page = find_page (memory, address);
+  if (!present (page, address)) {
     word_t *data = malloc (sizeof word);
     *data = word;
     add_memory (memory, address, 1, data);
     return;
   }
 
-  setword (area, address, word);
+  page->data[WORD_INDEX (address)] = word;
+  memory->generation++;
 }
 
 int
 pure_word_at (struct pdp10_memory *memory, int address)
 {
-  struct pdp10_area *area;
+  struct pdp10_page *page;
 
-  area = find_area (memory, address);
-  if (area == NULL)
+  page = find_page (memory, address);
+  if (!present (page, address))
+    return 0;
+
+  return (page->flags & MEMORY_PURE) != 0;
+}
+
+/* A memo for each word, which calc_e uses to remember where an
+   indirect word leads.  An entry holds the memory generation in the
+   high half, so every write to memory makes all of them stale.  The
+   memo for a page is allocated when first needed, and may be used by
+   several threads at once. */
+int
+get_indirect_memo (struct pdp10_memory *memory, int address, int *e)
+{
+  struct pdp10_page *page;
+  unsigned long long *memo, entry;
+
+  page = find_page (memory, address);
+  if (page == NULL)
+    return 0;
+  memo = __atomic_load_n (&page->indirect, __ATOMIC_ACQUIRE);
+  if (memo == NULL)
+    return 0;
+
+  entry = __atomic_load_n (&memo[WORD_INDEX (address)], __ATOMIC_RELAXED);
+  if ((entry >> 32) != memory->generation)
+    return 0;
+  *e = (int)(entry & 0xFFFFFFFF);
+  return 1;
+}
+
+void
+set_indirect_memo (struct pdp10_memory *memory, int address, int e)
+{
+  struct pdp10_page *page;
+  unsigned long long *memo, *expected = NULL, entry;
+
+  page = find_page (memory, address);
+  if (page == NULL)
+    return;
+
+  memo = __atomic_load_n (&page->indirect, __ATOMIC_ACQUIRE);
+  if (memo == NULL)
+    {
+      memo = xcalloc (MEMORY_PAGESIZE, sizeof *memo);
+      if (!__atomic_compare_exchange_n (&page->indirect, &expected, memo, 0,
+					__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+	{
+	  free (memo);
+	  memo = expected;
+	}
+    }
+
+  entry = ((unsigned long long)memory->generation << 32) | (unsigned)e;
+  __atomic_store_n (&memo[WORD_INDEX (address)], entry, __ATOMIC_RELAXED);
+}
+
+/* Words which have been found to be instructions, by discover_code.
+   Return 1 if the word is present and wasn't marked before. */
+int
+mark_code (struct pdp10_memory *memory, int address)
+{
+  struct pdp10_page *page;
+  unsigned long long bit;
+  int i;
+
+  page = find_page (memory, address);
+  if (!present (page, address))
+    return 0;
+
+  i = WORD_INDEX (address);
+  bit = 1ULL << (i % 64);
+  if (page->code[i / 64] & bit)
+    return 0;
+  page->code[i / 64] |= bit;
+  return 1;
+}
+
+int
+code_word_at (struct pdp10_memory *memory, int address)
+{
+  struct pdp10_page *page;
+  int i;
+
+  page = find_page (memory, address);
+  if (!present (page, address))
     return 0;
 
-  return !IMPURE (area);
+  i = WORD_INDEX (address);
+  return (page->code[i / 64] >> (i % 64)) & 1;
 }
@@ -20,22 +20,43 @@
 
 #define MEMORY_PURE     0001
 
+/* Addresses are up to 30 bits: 18 bits within a section, and a
+   section number.  Pages are 512 words. */
+#define MEMORY_ADDRESS_BITS	30
+#define MEMORY_SECTION_BITS	18
+#define MEMORY_PAGE_BITS	9
+#define MEMORY_PAGESIZE		(1 << MEMORY_PAGE_BITS)
+#define MEMORY_SECTIONS		(1 << (MEMORY_ADDRESS_BITS - MEMORY_SECTION_BITS))
+#define MEMORY_SECTION_PAGES	(1 << (MEMORY_SECTION_BITS - MEMORY_PAGE_BITS))
+
 struct pdp10_area
 {
   int start, end;
   unsigned flags;
-  word_t *data;
+};
+
+struct pdp10_page
+{
+  unsigned flags;
+  unsigned long long present[MEMORY_PAGESIZE / 64];
+  unsigned long long code[MEMORY_PAGESIZE / 64];	/* See mark_code. */
+  word_t data[MEMORY_PAGESIZE];
+  unsigned long long *indirect;	/* See get_indirect_memo. */
 };
 
 struct pdp10_memory
 {
   int			areas;
+  int			allocated;
   struct pdp10_area *	area;
   struct pdp10_area *	current_area;
   int			current_address;
+  struct pdp10_page ***	section;
+  unsigned		generation;	/* Changed by every write. */
 };
 
 extern void	init_memory (struct pdp10_memory *memory);
+extern void	free_memory (struct pdp10_memory *memory);
 extern int	add_memory (struct pdp10_memory *memory,
 			    int address, int length, word_t *data);
 extern void	remove_memory (struct pdp10_memory *memory,
@@ -48,5 +69,11 @@ extern word_t	get_next_word (struct pdp10_memory *memory);
 extern word_t	get_word_at (struct pdp10_memory *memory, int address);
 extern void	set_word_at (struct pdp10_memory *memory, int address, word_t);
 extern int	pure_word_at (struct pdp10_memory *memory, int address);
+extern int	get_indirect_memo (struct pdp10_memory *memory, int address,
+				   int *e);
+extern void	set_indirect_memo (struct pdp10_memory *memory, int address,
+				   int e);
+extern int	mark_code (struct pdp10_memory *memory, int address);
+extern int	code_word_at (struct pdp10_memory *memory, int address);
 
 #endif /* MEMORY_H */
@@ -31,9 +31,9 @@
 #define CR 015
 #define MASK 0177777
 #define NO_ADDRESS -2
-static int previous_address;
+static __thread int previous_address;
 
-static int quantity, address;
+static __thread int quantity, address;
 
 static void
 write_location (FILE *f, struct pdp10_memory *memory, int address)
@@ -74,8 +74,8 @@ write_odt (FILE *f, struct pdp10_memory *memory)
     fputc (CR, f);
 
   /* Start. */
-  if (start_instruction > 0)
-    fprintf (f, "%06lloG", start_instruction & MASK);
+  if (file_context->start_instruction > 0)
+    fprintf (f, "%06lloG", file_context->start_instruction & MASK);
 }
 
 static void
@@ -125,7 +125,7 @@ read_char (char c, struct pdp10_memory *memory)
 	quantity = -quantity;
       break;
     case 'G':
-      start_instruction = quantity;
+      file_context->start_instruction = quantity;
       quantity = 0;
       break;
     }
@@ -136,7 +136,7 @@ read_odt (FILE *f, struct pdp10_memory *memory, int cpu_model)
 {
   (void)cpu_model;
 
-  fprintf (output_file, ";ODT commands\n\n");
+  fprintf (file_context->output, ";ODT commands\n\n");
 
   quantity = 0;
   address = -1;
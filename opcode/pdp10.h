@@ -57,6 +57,14 @@ the Free Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307
  * PDP10_EXTEND means that this the first word of a two-word
  * instruction.  The second word is located at the effective address,
  * E, of the first instruction word.
+ *
+ * The rest of the types say how the instruction passes on control.
+ * PDP10_SKIP means it may skip the next word, PDP10_JUMP that it may
+ * jump to E, PDP10_CALL that it calls E and returns to the next word,
+ * and PDP10_XCT that it executes the word at E.  PDP10_STORE_PC means
+ * the return address is stored at E, and the call goes to E+1.
+ * PDP10_NO_NEXT means it never goes on to the next word, as an
+ * unconditional jump or skip, or a return.
  */
 
 #define PDP10_BASIC		0000
@@ -67,6 +75,12 @@ the Free Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307
 #define PDP10_A_E_UNUSED	(PDP10_A_UNUSED | PDP10_E_UNUSED)
 #define PDP10_IO		0020
 #define PDP10_EXTEND		0040
+#define PDP10_SKIP		0100
+#define PDP10_JUMP		0200
+#define PDP10_CALL		0400
+#define PDP10_XCT		01000
+#define PDP10_STORE_PC		02000
+#define PDP10_NO_NEXT		04000
 
 /*
  * PDP-10 CPU models.
@@ -18,7 +18,7 @@
 #include "dis.h"
 #include "memory.h"
 
-static int checksum;
+static __thread int checksum;
 
 static int
 get_8 (FILE *f)
@@ -47,7 +47,7 @@ read_palx (FILE *f, struct pdp10_memory *memory, int cpu_model)
   word_t *core;
 
   (void)cpu_model;
-  start_instruction = 1;
+  file_context->start_instruction = 1;
 
   for (;;)
     {
@@ -70,7 +70,7 @@ read_palx (FILE *f, struct pdp10_memory *memory, int cpu_model)
       if (length == 0)
         {
           if ((address & 1) == 0)
-            start_instruction = address;
+            file_context->start_instruction = address;
           return;
         }
 
@@ -129,8 +129,8 @@ write_palx (FILE *f, struct pdp10_memory *memory)
 
   out_16 (f, 0x0001);
   out_16 (f, 0x0006);
-  if (start_instruction != 0)
-    out_16 (f, start_instruction & 0177777);
+  if (file_context->start_instruction != 0)
+    out_16 (f, file_context->start_instruction & 0177777);
   else
     out_16 (f, 0x0001);
 }
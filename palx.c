@@ -174,7 +174,7 @@ main (int argc, char **argv)
 {
   int opt;
 
-  input_word_format = &its_word_format;
+  word_context->input_format = &its_word_format;
   symtab_fn = no_symtab;
 
   while ((opt = getopt (argc, argv, "AISW:")) != -1)
@@ -151,132 +151,133 @@ const struct pdp10_instruction pdp10_instruction[] =
   /* name,	opcode,	type,		models,   hint */
 
 #if 1 /* ITS MUUOs */
-  { ".iot",	0040,	PDP10_BASIC,	PDP10_ITS, HINT_CHANNEL, 0 },
-  { ".open",	0041,	PDP10_BASIC,	PDP10_ITS, HINT_CHANNEL, 0 },
-  { ".oper",	0042,	PDP10_BASIC,	PDP10_ITS, 0, 0 },
-  { ".call",	004300,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".dismis",	004304,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
+  { ".iot",	0040,	PDP10_SKIP,	PDP10_ITS, HINT_CHANNEL, 0 },
+  { ".open",	0041,	PDP10_SKIP,	PDP10_ITS, HINT_CHANNEL, 0 },
+  { ".oper",	0042,	PDP10_SKIP,	PDP10_ITS, 0, 0 },
+  { ".call",	004300,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".dismis",	004304,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
 #if 1
-  { ".lose",	004310,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
+  { ".lose",	004310,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
 #else
-  { ".trans",	004310,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
+  { ".trans",	004310,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
 #endif
-  { ".tranad",	004314,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".value",	004320,	PDP10_A_OPCODE|PDP10_E_UNUSED, PDP10_ITS, 0, 0 },
-  { ".utran",	004324,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".core",	004330,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".trand",	004334,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".dstart",	004340,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".fdele",	004344,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".dstrtl",	004350,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".suset",	004354,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".ltpen",	004360,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".vscan",	004364,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".potset",	004370,	PDP10_A_OPCODE,	PDP10_ITS, 0, 0 },
-  { ".uset",	0044,	PDP10_BASIC,	PDP10_ITS, HINT_CHANNEL, 0 },
-  { ".break",	0045,	PDP10_BASIC,	PDP10_ITS, HINT_NUMBER, 0 },
-  { ".status",	0046,	PDP10_BASIC,	PDP10_ITS, HINT_CHANNEL, 0 },
-  { ".access",	0047,	PDP10_BASIC,	PDP10_ITS, HINT_CHANNEL, 0 },
+  { ".tranad",	004314,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".value",	004320,	PDP10_A_OPCODE | PDP10_E_UNUSED | PDP10_SKIP,
+					PDP10_ITS, 0, 0 },
+  { ".utran",	004324,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".core",	004330,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".trand",	004334,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".dstart",	004340,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".fdele",	004344,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".dstrtl",	004350,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".suset",	004354,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".ltpen",	004360,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".vscan",	004364,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".potset",	004370,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_ITS, 0, 0 },
+  { ".uset",	0044,	PDP10_SKIP,	PDP10_ITS, HINT_CHANNEL, 0 },
+  { ".break",	0045,	PDP10_SKIP,	PDP10_ITS, HINT_NUMBER, 0 },
+  { ".status",	0046,	PDP10_SKIP,	PDP10_ITS, HINT_CHANNEL, 0 },
+  { ".access",	0047,	PDP10_SKIP,	PDP10_ITS, HINT_CHANNEL, 0 },
 #endif
 
   /* WAITS UUOs */
-  { "call",	0040,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "init",	0041,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "spcwar",	0043,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "calli",	0047,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "open",	0050,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "inchrw",	005100,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "outchr",	005104,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "inchrs",	005110,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "outstr",	005114,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "inchwl",	005120,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "inchsl",	005124,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "getlin",	005130,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "setlin",	005134,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "rescan",	005140,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "clrbfi",	005144,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "clrbfo",	005150,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "inskip",	005154,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "inwait",	005160,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "setact",	005164,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ttread",	005170,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "outfiv",	005174,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "rename",	0055,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "in",	0056,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "out",	0057,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "setsts",	0060,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "stato",	0061,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "getsts",	0062,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "statz",	0063,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "inbuf",	0064,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "outbuf",	0065,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "input",	0066,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "output",	0067,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "close",	0070,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "releas",	0071,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "mtape",	0072,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "ugetf",	0073,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "useti",	0074,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "useto",	0075,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "lookup",	0076,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "enter",	0077,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "dpyclr",	0701,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "ppsel",	070200,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ppact",	070204,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "dpypos",	070210,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "dpysiz",	070214,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "pprel",	070220,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ppinfo",	070224,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "leypos",	070230,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "pphld",	070234,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "cursor",	070240,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "upgiot",	0703,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "uinbf",	0704,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "uoutbf",	0705,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "send",	071000,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "wrcv",	071004,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "srcv",	071010,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "skpme",	071014,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "skphim",	071020,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "skpsen",	071024,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptyget",	071100,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptyrel",	071104,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptifre",	071110,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptocnt",	071114,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptrd1s",	071110,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptrd1w",	071114,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptwr1s",	071110,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptwr1w",	071114,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptrds",	071110,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptwrs7",	071114,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptwrs9",	071110,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptgetl",	071114,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptsetl",	071110,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptload",	071114,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptjobx",	071110,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ptl7w9",	071114,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "points",	0712,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "upgmve",	0713,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "upgmvm",	0714,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "pgsel",	071500,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "pgact",	071504,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "pgclr",	071510,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "ddupg",	071514,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "pginfo",	071520,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "chnsts",	0716,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "clkint",	0717,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "intmsk",	0720,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "imskst",	0721,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "imskcl",	0722,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "intdej",	072300,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "imstw",	072304,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "iwkmsk",	072310,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "intdmp",	072314,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "intipi",	072320,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "imskcr",	072324,	PDP10_A_OPCODE,	PDP10_SAIL, 0, 0 },
-  { "iopush",	0724,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "iopop",	0725,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
-  { "iopdl",	0726,	PDP10_BASIC,	PDP10_SAIL, 0, 0 },
+  { "call",	0040,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "init",	0041,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "spcwar",	0043,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "calli",	0047,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "open",	0050,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "inchrw",	005100,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "outchr",	005104,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "inchrs",	005110,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "outstr",	005114,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "inchwl",	005120,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "inchsl",	005124,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "getlin",	005130,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "setlin",	005134,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "rescan",	005140,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "clrbfi",	005144,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "clrbfo",	005150,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "inskip",	005154,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "inwait",	005160,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "setact",	005164,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ttread",	005170,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "outfiv",	005174,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "rename",	0055,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "in",	0056,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "out",	0057,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "setsts",	0060,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "stato",	0061,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "getsts",	0062,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "statz",	0063,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "inbuf",	0064,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "outbuf",	0065,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "input",	0066,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "output",	0067,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "close",	0070,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "releas",	0071,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "mtape",	0072,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "ugetf",	0073,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "useti",	0074,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "useto",	0075,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "lookup",	0076,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "enter",	0077,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "dpyclr",	0701,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "ppsel",	070200,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ppact",	070204,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "dpypos",	070210,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "dpysiz",	070214,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "pprel",	070220,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ppinfo",	070224,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "leypos",	070230,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "pphld",	070234,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "cursor",	070240,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "upgiot",	0703,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "uinbf",	0704,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "uoutbf",	0705,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "send",	071000,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "wrcv",	071004,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "srcv",	071010,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "skpme",	071014,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "skphim",	071020,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "skpsen",	071024,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptyget",	071100,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptyrel",	071104,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptifre",	071110,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptocnt",	071114,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptrd1s",	071110,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptrd1w",	071114,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptwr1s",	071110,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptwr1w",	071114,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptrds",	071110,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptwrs7",	071114,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptwrs9",	071110,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptgetl",	071114,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptsetl",	071110,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptload",	071114,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptjobx",	071110,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ptl7w9",	071114,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "points",	0712,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "upgmve",	0713,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "upgmvm",	0714,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "pgsel",	071500,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "pgact",	071504,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "pgclr",	071510,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "ddupg",	071514,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "pginfo",	071520,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "chnsts",	0716,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "clkint",	0717,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "intmsk",	0720,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "imskst",	0721,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "imskcl",	0722,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "intdej",	072300,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "imstw",	072304,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "iwkmsk",	072310,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "intdmp",	072314,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "intipi",	072320,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "imskcr",	072324,	PDP10_A_OPCODE | PDP10_SKIP, PDP10_SAIL, 0, 0 },
+  { "iopush",	0724,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "iopop",	0725,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
+  { "iopdl",	0726,	PDP10_SKIP,	PDP10_SAIL, 0, 0 },
 
   /* TOPS-xx instruction */
   { "ujen",	0100,	PDP10_BASIC,	PDP10_KI10up, 0, 0 },
@@ -286,7 +287,7 @@ const struct pdp10_instruction pdp10_instruction[] =
   { "gfsb",	0103,	PDP10_BASIC,	PDP10_KL10_271, 0, 0 },
 
   /* TOPS-20 instruction */
-  { "jsys",	0104,	PDP10_BASIC,	PDP10_KI10up, 0, 0 },
+  { "jsys",	0104,	PDP10_SKIP,	PDP10_KI10up, 0, 0 },
 
   { "adjsp",	0105,	PDP10_BASIC,	PDP10_KL10up, 0, 0 },
   { "gfmp",	0106,	PDP10_BASIC,	PDP10_KL10_271, 0, 0 },
@@ -389,15 +390,15 @@ const struct pdp10_instruction pdp10_instruction[] =
   { "ash",	0240,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "rot",	0241,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "lsh",	0242,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jffo",	0243,	PDP10_BASIC,	PDP10_KA10up, 0, 0 },
+  { "jffo",	0243,	PDP10_JUMP,	PDP10_KA10up, 0, 0 },
   { "ashc",	0244,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "rotc",	0245,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "lshc",	0246,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "fix",	0247,	PDP10_BASIC,	PDP10_KA10_SAIL, 0, 0 },
   { "exch",	0250,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "blt",	0251,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "aobjp",	0252,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "aobjn",	0253,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "aobjp",	0252,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "aobjn",	0253,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
 
   /*
    * JRST instruction family.
@@ -405,16 +406,20 @@ const struct pdp10_instruction pdp10_instruction[] =
    * Mnemonics for the most common instructions are recognized.  The
    * rest are caught by the last entry.
    */
-  { "portal",	025404,	PDP10_A_OPCODE,	PDP10_ALL, 0, 0 },
-  { "jrstf",	025410,	PDP10_A_OPCODE,	PDP10_ALL, 0, 0 },
-  { "halt",	025420,	PDP10_A_OPCODE,	PDP10_ALL, 0, 0 },
-  { "xjrstf",	025424,	PDP10_A_OPCODE,	PDP10_KL10up, 0, 0 },
-  { "xjen",	025430,	PDP10_A_OPCODE,	PDP10_KL10up, 0, 0 },
-  { "xpcw",	025434,	PDP10_A_OPCODE,	PDP10_KL10up, 0, 0 },
+  { "portal",	025404,	PDP10_A_OPCODE | PDP10_JUMP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, 0 },
+  { "jrstf",	025410,	PDP10_A_OPCODE | PDP10_JUMP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, 0 },
+  { "halt",	025420,	PDP10_A_OPCODE | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "xjrstf",	025424,	PDP10_A_OPCODE | PDP10_NO_NEXT, PDP10_KL10up, 0, 0 },
+  { "xjen",	025430,	PDP10_A_OPCODE | PDP10_NO_NEXT, PDP10_KL10up, 0, 0 },
+  { "xpcw",	025434,	PDP10_A_OPCODE | PDP10_NO_NEXT, PDP10_KL10up, 0, 0 },
 /*{ "jrstil",	025440,	PDP10_A_OPCODE,	PDP10_ALL },*/
-  { "jen",	025450,	PDP10_A_OPCODE,	PDP10_ALL, 0, 0 },
+  { "jen",	025450,	PDP10_A_OPCODE | PDP10_JUMP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, 0 },
   { "sfm",	025460,	PDP10_A_OPCODE,	PDP10_KL10up, 0, 0 },
-  { "jrst",	0254,	PDP10_A_UNUSED,	PDP10_ALL, HINT_NUMBER, 0 },
+  { "jrst",	0254,	PDP10_A_UNUSED | PDP10_JUMP | PDP10_NO_NEXT,
+					PDP10_ALL, HINT_NUMBER, 0 },
 
   /*
    * JFCL instruction family.
@@ -426,27 +431,28 @@ const struct pdp10_instruction pdp10_instruction[] =
   { "jfcl",	025500,	PDP10_A_OPCODE | PDP10_E_UNUSED,
 					PDP10_ALL, 0, 0 },
 /*{ "jpcch",	025504,	PDP10_A_OPCODE,	PDP6_166 },*/
-  { "jfov",	025504,	PDP10_A_OPCODE,	PDP10_KA10up, 0, 0 },
-  { "jcry1",	025510,	PDP10_A_OPCODE,	PDP10_ALL, 0, 0 },
-  { "jcry0",	025520,	PDP10_A_OPCODE,	PDP10_ALL, 0, 0 },
-  { "jcry",	025530,	PDP10_A_OPCODE,	PDP10_ALL, 0, 0 },
-  { "jov",	025540,	PDP10_A_OPCODE,	PDP10_ALL, 0, 0 },
-  { "jfcl",	0255,	PDP10_BASIC,	PDP10_ALL, HINT_NUMBER, 0 },
+  { "jfov",	025504,	PDP10_A_OPCODE | PDP10_JUMP, PDP10_KA10up, 0, 0 },
+  { "jcry1",	025510,	PDP10_A_OPCODE | PDP10_JUMP, PDP10_ALL, 0, 0 },
+  { "jcry0",	025520,	PDP10_A_OPCODE | PDP10_JUMP, PDP10_ALL, 0, 0 },
+  { "jcry",	025530,	PDP10_A_OPCODE | PDP10_JUMP, PDP10_ALL, 0, 0 },
+  { "jov",	025540,	PDP10_A_OPCODE | PDP10_JUMP, PDP10_ALL, 0, 0 },
+  { "jfcl",	0255,	PDP10_JUMP,	PDP10_ALL, HINT_NUMBER, 0 },
 
-  { "xct",	0256,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
+  { "xct",	0256,	PDP10_A_UNUSED | PDP10_XCT, PDP10_ALL, 0, 0 },
 
   /* TOPS-10 instruction, CONS at SAIL, nop otherwise */
   { "map",	0257,	PDP10_BASIC,	PDP10_KA10_to_KI10, 0, 0 },
   { "cons",	0257,	PDP10_BASIC,	PDP10_KA10_SAIL, 0, 0 },
 
-  { "pushj",	0260,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "pushj",	0260,	PDP10_CALL,	PDP10_ALL, 0, 0 },
   { "push",	0261,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "pop",	0262,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "popj",	0263,	PDP10_E_UNUSED,	PDP10_ALL, 0, 0 },
-  { "jsr",	0264,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "jsp",	0265,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jsa",	0266,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jra",	0267,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "popj",	0263,	PDP10_E_UNUSED | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "jsr",	0264,	PDP10_A_UNUSED | PDP10_CALL | PDP10_STORE_PC,
+					PDP10_ALL, 0, 0 },
+  { "jsp",	0265,	PDP10_CALL,	PDP10_ALL, 0, 0 },
+  { "jsa",	0266,	PDP10_CALL | PDP10_STORE_PC, PDP10_ALL, 0, 0 },
+  { "jra",	0267,	PDP10_NO_NEXT,	PDP10_ALL, 0, 0 },
   { "add",	0270,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "addi",	0271,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "addm",	0272,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
@@ -456,69 +462,73 @@ const struct pdp10_instruction pdp10_instruction[] =
   { "subm",	0276,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "subb",	0277,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "cai",	0300,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "cail",	0301,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "caie",	0302,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "caile",	0303,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "caia",	0304,	PDP10_A_E_UNUSED, PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "caige",	0305,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "cain",	0306,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "caig",	0307,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "cail",	0301,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "caie",	0302,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "caile",	0303,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "caia",	0304,	PDP10_A_E_UNUSED | PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "caige",	0305,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "cain",	0306,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "caig",	0307,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "cam",	0310,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "caml",	0311,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "came",	0312,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "camle",	0313,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "cama",	0314,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "camge",	0315,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "camn",	0316,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "camg",	0317,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "caml",	0311,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "came",	0312,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "camle",	0313,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "cama",	0314,	PDP10_SKIP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "camge",	0315,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "camn",	0316,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "camg",	0317,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
   { "jump",	0320,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jumpl",	0321,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jumpe",	0322,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jumple",	0323,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jumpa",	0324,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jumpge",	0325,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jumpn",	0326,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "jumpg",	0327,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "jumpl",	0321,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "jumpe",	0322,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "jumple",	0323,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "jumpa",	0324,	PDP10_JUMP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "jumpge",	0325,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "jumpn",	0326,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "jumpg",	0327,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
   { "skip",	0330,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "skipl",	0331,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "skipe",	0332,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "skiple",	0333,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "skipa",	0334,	PDP10_A_E_UNUSED, PDP10_ALL, 0, 0 },
-  { "skipge",	0335,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "skipn",	0336,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "skipg",	0337,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
+  { "skipl",	0331,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "skipe",	0332,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "skiple",	0333,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "skipa",	0334,	PDP10_A_E_UNUSED | PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, 0 },
+  { "skipge",	0335,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "skipn",	0336,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "skipg",	0337,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
   { "aoj",	0340,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "aojl",	0341,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "aoje",	0342,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "aojle",	0343,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "aoja",	0344,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "aojge",	0345,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "aojn",	0346,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "aojg",	0347,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "aojl",	0341,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "aoje",	0342,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "aojle",	0343,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "aoja",	0344,	PDP10_JUMP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "aojge",	0345,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "aojn",	0346,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "aojg",	0347,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
   { "aos",	0350,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "aosl",	0351,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "aose",	0352,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "aosle",	0353,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "aosa",	0354,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "aosge",	0355,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "aosn",	0356,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "aosg",	0357,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
+  { "aosl",	0351,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "aose",	0352,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "aosle",	0353,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "aosa",	0354,	PDP10_A_UNUSED | PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, 0 },
+  { "aosge",	0355,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "aosn",	0356,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "aosg",	0357,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
   { "soj",	0360,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "sojl",	0361,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "soje",	0362,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "sojle",	0363,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "soja",	0364,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "sojge",	0365,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "sojn",	0366,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "sojg",	0367,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "sojl",	0361,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "soje",	0362,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "sojle",	0363,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "soja",	0364,	PDP10_JUMP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "sojge",	0365,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "sojn",	0366,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
+  { "sojg",	0367,	PDP10_JUMP,	PDP10_ALL, 0, 0 },
   { "sos",	0370,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "sosl",	0371,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "sose",	0372,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "sosle",	0373,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "sosa",	0374,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "sosge",	0375,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "sosn",	0376,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
-  { "sosg",	0377,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
+  { "sosl",	0371,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "sose",	0372,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "sosle",	0373,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "sosa",	0374,	PDP10_A_UNUSED | PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, 0 },
+  { "sosge",	0375,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "sosn",	0376,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
+  { "sosg",	0377,	PDP10_A_UNUSED | PDP10_SKIP, PDP10_ALL, 0, 0 },
   { "setz",	0400,	PDP10_E_UNUSED,	PDP10_ALL, 0, 0 },
   { "setzi",	0401,	PDP10_E_UNUSED,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "setzm",	0402,	PDP10_A_UNUSED,	PDP10_ALL, 0, 0 },
@@ -649,68 +659,76 @@ const struct pdp10_instruction pdp10_instruction[] =
   { "hlres",	0577,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "trn",	0600,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "tln",	0601,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "trne",	0602,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlne",	0603,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "trna",	0604,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlna",	0605,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "trnn",	0606,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlnn",	0607,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "trne",	0602,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlne",	0603,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "trna",	0604,	PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlna",	0605,	PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "trnn",	0606,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlnn",	0607,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "tdn",	0610,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "tsn",	0611,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdne",	0612,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tsne",	0613,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdna",	0614,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tsna",	0615,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdnn",	0616,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tsnn",	0617,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "tdne",	0612,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tsne",	0613,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tdna",	0614,	PDP10_SKIP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "tsna",	0615,	PDP10_SKIP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "tdnn",	0616,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tsnn",	0617,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
   { "trz",	0620,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "tlz",	0621,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "trze",	0622,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlze",	0623,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "trza",	0624,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlza",	0625,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "trzn",	0626,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlzn",	0627,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "trze",	0622,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlze",	0623,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "trza",	0624,	PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlza",	0625,	PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "trzn",	0626,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlzn",	0627,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "tdz",	0630,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "tsz",	0631,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdze",	0632,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tsze",	0633,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdza",	0634,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tsza",	0635,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdzn",	0636,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tszn",	0637,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "tdze",	0632,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tsze",	0633,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tdza",	0634,	PDP10_SKIP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "tsza",	0635,	PDP10_SKIP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "tdzn",	0636,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tszn",	0637,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
   { "trc",	0640,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "tlc",	0641,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "trce",	0642,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlce",	0643,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "trca",	0644,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlca",	0645,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "trcn",	0646,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlcn",	0647,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "trce",	0642,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlce",	0643,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "trca",	0644,	PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlca",	0645,	PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "trcn",	0646,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlcn",	0647,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "tdc",	0650,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "tsc",	0651,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdce",	0652,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tsce",	0653,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdca",	0654,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tsca",	0655,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdcn",	0656,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tscn",	0657,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "tdce",	0652,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tsce",	0653,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tdca",	0654,	PDP10_SKIP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "tsca",	0655,	PDP10_SKIP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "tdcn",	0656,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tscn",	0657,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
   { "tro",	0660,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "tlo",	0661,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "troe",	0662,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tloe",	0663,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "troa",	0664,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tloa",	0665,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tron",	0666,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
-  { "tlon",	0667,	PDP10_BASIC,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "troe",	0662,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tloe",	0663,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "troa",	0664,	PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tloa",	0665,	PDP10_SKIP | PDP10_NO_NEXT,
+					PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tron",	0666,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
+  { "tlon",	0667,	PDP10_SKIP,	PDP10_ALL, 0, HINT_IMMEDIATE },
   { "tdo",	0670,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
   { "tso",	0671,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdoe",	0672,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tsoe",	0673,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdoa",	0674,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tsoa",	0675,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tdon",	0676,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
-  { "tson",	0677,	PDP10_BASIC,	PDP10_ALL, 0, 0 },
+  { "tdoe",	0672,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tsoe",	0673,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tdoa",	0674,	PDP10_SKIP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "tsoa",	0675,	PDP10_SKIP | PDP10_NO_NEXT, PDP10_ALL, 0, 0 },
+  { "tdon",	0676,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
+  { "tson",	0677,	PDP10_SKIP,	PDP10_ALL, 0, 0 },
 
 #if 1
   /*
@@ -850,14 +868,14 @@ const struct pdp10_instruction pdp10_instruction[] =
   { "wrhsb",	070270,	PDP10_A_OPCODE,	PDP10_KS10, 0, 0 },
   { "umove",	0704,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
   { "umovem",	0705,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
-  { "tioe",	0710,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
-  { "tion",	0711,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
+  { "tioe",	0710,	PDP10_SKIP,	PDP10_KS10, 0, 0 },
+  { "tion",	0711,	PDP10_SKIP,	PDP10_KS10, 0, 0 },
   { "rdio",	0712,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
   { "wrio",	0713,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
   { "bsio",	0714,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
   { "bcio",	0715,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
-  { "tioeb",	0720,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
-  { "tionb",	0721,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
+  { "tioeb",	0720,	PDP10_SKIP,	PDP10_KS10, 0, 0 },
+  { "tionb",	0721,	PDP10_SKIP,	PDP10_KS10, 0, 0 },
   { "rdiob",	0722,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
   { "wriob",	0723,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
   { "bsiob",	0724,	PDP10_BASIC,	PDP10_KS10, 0, 0 },
@@ -926,14 +944,14 @@ const struct pdp10_instruction pdp10_instruction[] =
 #define PDP10_not_KS10_or_XKL1 (PDP10_ALL & ~(PDP10_KS10 | \
 				PDP10_XKL1))
 
-  { "blki",	070000,	PDP10_IO,	PDP10_not_KS10_or_XKL1, 0, 0 },
+  { "blki",	070000,	PDP10_IO | PDP10_SKIP, PDP10_not_KS10_or_XKL1, 0, 0 },
   { "datai",	070004,	PDP10_IO,	PDP10_not_KS10_or_XKL1, 0, 0 },
-  { "blko",	070010,	PDP10_IO,	PDP10_not_KS10_or_XKL1, 0, 0 },
+  { "blko",	070010,	PDP10_IO | PDP10_SKIP, PDP10_not_KS10_or_XKL1, 0, 0 },
   { "datao",	070014,	PDP10_IO,	PDP10_not_KS10_or_XKL1, 0, 0 },
   { "cono",	070020,	PDP10_IO,	PDP10_not_KS10_or_XKL1, 0, 0 },
   { "coni",	070024,	PDP10_IO,	PDP10_not_KS10_or_XKL1, 0, 0 },
-  { "consz",	070030,	PDP10_IO,	PDP10_not_KS10_or_XKL1, 0, 0 },
-  { "conso",	070034,	PDP10_IO,	PDP10_not_KS10_or_XKL1, 0, 0 },
+  { "consz",	070030,	PDP10_IO | PDP10_SKIP, PDP10_not_KS10_or_XKL1, 0, 0 },
+  { "conso",	070034,	PDP10_IO | PDP10_SKIP, PDP10_not_KS10_or_XKL1, 0, 0 },
 };
 
 /*
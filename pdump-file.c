@@ -49,13 +49,13 @@ read_pdump (FILE *f, struct pdp10_memory *memory, int cpu_model)
   word_t word;
   int i, j;
 
-  fprintf (output_file, "PDUMP format\n\n");
+  fprintf (file_context->output, "PDUMP format\n\n");
 
   /* zero word */
   word = get_word (f);
 
-  fprintf (output_file, "Page map:\n");
-  fprintf (output_file, "Page  Address  Page description\n");
+  fprintf (file_context->output, "Page map:\n");
+  fprintf (file_context->output, "Page  Address  Page description\n");
   for (i = 0; i < 256; i++)
     {
       word = get_word (f);
@@ -63,18 +63,18 @@ read_pdump (FILE *f, struct pdp10_memory *memory, int cpu_model)
 
       if (word != 0)
 	{
-	  fprintf (output_file, "%03o   %06o   %06o,,%06o  ",
+	  fprintf (file_context->output, "%03o   %06o   %06o,,%06o  ",
 		  i, ITS_PAGESIZE * i, (int)(word >> 18), (int)word & 0777777);
 
-	  fprintf (output_file, word & PAGE_ABS ? "a" : "-");
-	  fprintf (output_file, word & PAGE_CBCPY ? "c" : "-");
-	  fprintf (output_file, word & PAGE_SHARE ? "s" : "-");
-	  fprintf (output_file, word & PAGE_WRITE ? "w" : "-");
-	  fprintf (output_file, word & PAGE_READ ? "r" : "-");
+	  fprintf (file_context->output, word & PAGE_ABS ? "a" : "-");
+	  fprintf (file_context->output, word & PAGE_CBCPY ? "c" : "-");
+	  fprintf (file_context->output, word & PAGE_SHARE ? "s" : "-");
+	  fprintf (file_context->output, word & PAGE_WRITE ? "w" : "-");
+	  fprintf (file_context->output, word & PAGE_READ ? "r" : "-");
 	  if (word & PAGE_NUM)
-	    fprintf (output_file, " %03o", (int)(word & PAGE_NUM));
+	    fprintf (file_context->output, " %03o", (int)(word & PAGE_NUM));
 
-	  fprintf (output_file, "\n");
+	  fprintf (file_context->output, "\n");
 	}
     }
 
@@ -109,9 +109,9 @@ read_pdump (FILE *f, struct pdp10_memory *memory, int cpu_model)
 	purify_memory (memory, ITS_PAGESIZE * i, ITS_PAGESIZE);
     }
 
-  fprintf (output_file, "\n");
+  fprintf (file_context->output, "\n");
   word = get_word (f);
-  start_instruction = word;
+  file_context->start_instruction = word;
   sblk_info (f, word, cpu_model);
 }
 
@@ -150,9 +150,9 @@ write_pdump (FILE *f, struct pdp10_memory *memory)
     }
 
   /* Round off like an SBLK file. */
-  write_word (f, start_instruction);
+  write_word (f, file_context->start_instruction);
   write_sblk_symbols (f);
-  write_word (f, start_instruction);
+  write_word (f, file_context->start_instruction);
 }
 
 struct file_format pdump_file_format = {
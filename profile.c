@@ -0,0 +1,671 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Static profile of a loaded image.  The code found by discover_code
+   is split into basic blocks, and the estimated execution time from
+   the KA10 or KI10 timing model is added up per block, per routine,
+   and per loop.  A routine runs from one code label to the next.  A
+   loop is found from a jump or skip to a block which dominates it,
+   i.e. which every path to the jump passes through, and is made up of
+   the blocks which can reach the jump without passing through the
+   loop head.  Calls are not followed, so the time for a
+   loop is for one iteration, not counting the routines it calls. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "opcode/pdp10.h"
+#include "dis.h"
+#include "memory.h"
+#include "symbols.h"
+#include "timing.h"
+
+/* How many loops to show. */
+#define PROFILE_LOOPS 20
+
+struct block
+{
+  int start, end;		/* The end is the first address after. */
+  int instructions;
+  long long time;
+  int flow, target;		/* From the last instruction. */
+  int routine;
+  int depth;			/* How many loops the block is in. */
+  int mark;
+};
+
+struct routine
+{
+  int start;
+  const char *name;
+  int blocks, instructions, loops;
+  long long time;
+};
+
+struct loop
+{
+  int header, latch;		/* Block indices. */
+  int blocks, instructions, calls;
+  long long time;
+};
+
+struct profile
+{
+  struct block *block;
+  int blocks;
+  struct routine *routine;
+  int routines;
+  struct loop *loop;
+  int loops, loop_size;
+  int *pred_start, *pred;	/* Predecessors of each block. */
+  int *idom, *post;		/* Dominator tree, and DFS post order. */
+};
+
+static void *
+grow (void *p, int n, int *size, size_t element)
+{
+  if (n < *size)
+    return p;
+  *size = *size ? 2 * *size : 1024;
+  p = realloc (p, *size * element);
+  if (p == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  return p;
+}
+
+static int
+compare_ints (const void *a, const void *b)
+{
+  int x = *(const int *)a, y = *(const int *)b;
+  return x < y ? -1 : x > y;
+}
+
+/* Find the block which starts at an address, or -1. */
+static int
+find_block (const struct profile *p, int address)
+{
+  int low = 0, high = p->blocks, middle;
+
+  while (low < high)
+    {
+      middle = (low + high) / 2;
+      if (p->block[middle].start < address)
+	low = middle + 1;
+      else
+	high = middle;
+    }
+
+  if (low < p->blocks && p->block[low].start == address)
+    return low;
+  return -1;
+}
+
+static int
+target_address (int address, int target)
+{
+  return (address & ~0777777) | target;
+}
+
+/* Every jump target, and every word after an instruction which doesn't
+   just go on to the next, starts a block. */
+static int *
+find_leaders (struct pdp10_memory *memory, int cpu_model, int *n)
+{
+  int *leader = NULL, size = 0, count = 0;
+  int i, address, flow, target;
+
+  for (i = 0; i < memory->areas; i++)
+    for (address = memory->area[i].start;
+	 address < memory->area[i].end;
+	 address++)
+      {
+	if (!code_word_at (memory, address))
+	  continue;
+	flow = instruction_flow (get_word_at (memory, address),
+				 cpu_model, &target);
+	/* Data taken for code ends a block and goes nowhere. */
+	if (flow == -1)
+	  flow = 0;
+	leader = grow (leader, count + 3, &size, sizeof *leader);
+	if ((flow & (FLOW_JUMP | FLOW_CALL)) && target != -1)
+	  leader[count++] = target_address (address, target);
+	if (flow != FLOW_NEXT)
+	  leader[count++] = address + 1;
+	if (flow & FLOW_SKIP)
+	  leader[count++] = address + 2;
+      }
+
+  qsort (leader, count, sizeof *leader, compare_ints);
+  *n = count;
+  return leader;
+}
+
+static void
+find_blocks (struct profile *p, struct pdp10_memory *memory,
+	     int cpu_model, int timing)
+{
+  int *leader, leaders, next = 0, size = 0;
+  int i, address, flow, target, time;
+  struct block *b = NULL;
+  word_t word;
+
+  leader = find_leaders (memory, cpu_model, &leaders);
+
+  p->block = NULL;
+  p->blocks = 0;
+  for (i = 0; i < memory->areas; i++)
+    for (address = memory->area[i].start;
+	 address < memory->area[i].end;
+	 address++)
+      {
+	if (!code_word_at (memory, address))
+	  {
+	    b = NULL;
+	    continue;
+	  }
+
+	while (next < leaders && leader[next] < address)
+	  next++;
+	if (b == NULL || b->end != address || b->flow != FLOW_NEXT ||
+	    (next < leaders && leader[next] == address) ||
+	    get_symbol_by_value (address, HINT_ADDRESS) != NULL)
+	  {
+	    p->block = grow (p->block, p->blocks, &size, sizeof *p->block);
+	    b = &p->block[p->blocks++];
+	    b->start = address;
+	    b->instructions = 0;
+	    b->time = 0;
+	    b->routine = -1;
+	    b->depth = 0;
+	    b->mark = -1;
+	  }
+
+	word = get_word_at (memory, address);
+	flow = instruction_flow (word, cpu_model, &target);
+	if (flow == -1)
+	  flow = 0;
+	time = instruction_time (word, timing);
+	b->end = address + 1;
+	b->instructions++;
+	if (time > 0)
+	  b->time += time;
+	b->flow = flow;
+	b->target = target == -1 ? -1 : target_address (address, target);
+      }
+
+  free (leader);
+}
+
+/* Return one of the successors of a block: the next block, the one
+   after a skip, or the jump target.  A call goes on to the next block,
+   as if the routine called had returned.  Return -1 if there is no
+   such successor. */
+#define SUCCESSORS 3
+
+static int
+successor (const struct profile *p, int i, int which)
+{
+  const struct block *b = &p->block[i];
+
+  switch (which)
+    {
+    case 0:
+      return (b->flow & FLOW_NEXT) ? find_block (p, b->end) : -1;
+    case 1:
+      return (b->flow & FLOW_SKIP) ? find_block (p, b->end + 1) : -1;
+    default:
+      if ((b->flow & FLOW_JUMP) && b->target != -1)
+	return find_block (p, b->target);
+      return -1;
+    }
+}
+
+static void
+find_edges (struct profile *p)
+{
+  int i, j, k;
+
+  p->pred_start = calloc (p->blocks + 1, sizeof *p->pred_start);
+  if (p->pred_start == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  for (i = 0; i < p->blocks; i++)
+    for (k = 0; k < SUCCESSORS; k++)
+      if ((j = successor (p, i, k)) != -1)
+	p->pred_start[j + 1]++;
+  for (i = 0; i < p->blocks; i++)
+    p->pred_start[i + 1] += p->pred_start[i];
+
+  p->pred = malloc (p->pred_start[p->blocks] * sizeof *p->pred + 1);
+  if (p->pred == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  for (i = 0; i < p->blocks; i++)
+    for (k = 0; k < SUCCESSORS; k++)
+      if ((j = successor (p, i, k)) != -1)
+	p->pred[p->pred_start[j]++] = i;
+  /* Filling moved each start to the next block. */
+  for (i = p->blocks; i > 0; i--)
+    p->pred_start[i] = p->pred_start[i - 1];
+  p->pred_start[0] = 0;
+}
+
+static int
+intersect (const struct profile *p, int a, int b)
+{
+  while (a != b)
+    {
+      while (p->post[a] < p->post[b])
+	a = p->idom[a];
+      while (p->post[b] < p->post[a])
+	b = p->idom[b];
+    }
+  return a;
+}
+
+/* Does block a dominate block b? */
+static int
+dominates (const struct profile *p, int a, int b)
+{
+  while (b != a && b != p->blocks)
+    b = p->idom[b];
+  return b == a;
+}
+
+/* Build the dominator tree with the iterative algorithm by Cooper,
+   Harvey, and Kennedy.  An extra root, numbered after the last block,
+   leads to every block without predecessors and every block called.
+   Blocks still not reached are made roots too, in order of address. */
+static void
+find_dominators (struct profile *p)
+{
+  int n = p->blocks, *next, *stack, *order, *root, *pred;
+  int i, j, k, m, count, depth, block, changed;
+
+  p->idom = malloc ((n + 1) * sizeof *p->idom);
+  p->post = malloc ((n + 1) * sizeof *p->post);
+  next = malloc ((n + 1) * sizeof *next);
+  stack = malloc ((n + 1) * sizeof *stack);
+  order = malloc ((n + 1) * sizeof *order);
+  root = calloc (n + 1, sizeof *root);
+  if (p->idom == NULL || p->post == NULL || next == NULL ||
+      stack == NULL || order == NULL || root == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      next[i] = -1;
+      if (p->pred_start[i] == p->pred_start[i + 1])
+	root[i] = 1;
+      if ((p->block[i].flow & FLOW_CALL) && p->block[i].target != -1 &&
+	  (j = find_block (p, p->block[i].target)) != -1)
+	root[j] = 1;
+    }
+
+  /* Depth first, from the roots first, and then from the rest. */
+  count = 0;
+  for (k = 0; k < 2; k++)
+    for (i = 0; i < n; i++)
+      {
+	if (next[i] != -1 || (k == 0 && !root[i]))
+	  continue;
+	root[i] = 1;
+	next[i] = 0;
+	stack[0] = i;
+	depth = 1;
+	while (depth > 0)
+	  {
+	    block = stack[depth - 1];
+	    if (next[block] < SUCCESSORS)
+	      {
+		j = successor (p, block, next[block]++);
+		if (j != -1 && next[j] == -1)
+		  {
+		    next[j] = 0;
+		    stack[depth++] = j;
+		  }
+		continue;
+	      }
+	    depth--;
+	    p->post[block] = count;
+	    order[count++] = block;
+	  }
+      }
+
+  for (i = 0; i < n; i++)
+    p->idom[i] = -1;
+  p->idom[n] = n;
+  p->post[n] = n;
+
+  /* Go in reverse post order until nothing changes. */
+  do
+    {
+      changed = 0;
+      for (k = n - 1; k >= 0; k--)
+	{
+	  block = order[k];
+	  j = root[block] ? n : -1;
+	  pred = p->pred + p->pred_start[block];
+	  m = p->pred_start[block + 1] - p->pred_start[block];
+	  for (; m > 0; m--, pred++)
+	    if (p->idom[*pred] != -1)
+	      j = j == -1 ? *pred : intersect (p, *pred, j);
+	  if (p->idom[block] != j)
+	    {
+	      p->idom[block] = j;
+	      changed = 1;
+	    }
+	}
+    }
+  while (changed);
+
+  free (next);
+  free (stack);
+  free (order);
+  free (root);
+}
+
+static int
+compare_headers (const void *a, const void *b)
+{
+  const struct loop *x = a, *y = b;
+  return x->header < y->header ? -1 : x->header > y->header;
+}
+
+/* Each edge to a block which dominates it closes a loop.  Loops with
+   the same head are merged.  The blocks in a loop are found by walking
+   backwards from each latch until the head. */
+static void
+find_loops (struct profile *p)
+{
+  int *body, count, i, j, k, n, block;
+  struct loop *l;
+
+  p->loop = NULL;
+  p->loops = p->loop_size = 0;
+  for (i = 0; i < p->blocks; i++)
+    for (k = 0; k < SUCCESSORS; k++)
+      if ((j = successor (p, i, k)) != -1 && dominates (p, j, i))
+	{
+	  p->loop = grow (p->loop, p->loops, &p->loop_size, sizeof *p->loop);
+	  p->loop[p->loops].header = j;
+	  p->loop[p->loops].latch = i;
+	  p->loops++;
+	}
+
+  qsort (p->loop, p->loops, sizeof *p->loop, compare_headers);
+  body = malloc (p->blocks * sizeof *body + 1);
+  if (body == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+
+  for (i = n = 0; i < p->loops; i = j)
+    {
+      l = &p->loop[n];
+      *l = p->loop[i];
+
+      count = 0;
+      p->block[l->header].mark = i;
+      body[count++] = l->header;
+      for (j = i; j < p->loops && p->loop[j].header == l->header; j++)
+	{
+	  if (p->loop[j].latch > l->latch)
+	    l->latch = p->loop[j].latch;
+	  if (p->block[p->loop[j].latch].mark != i)
+	    {
+	      p->block[p->loop[j].latch].mark = i;
+	      body[count++] = p->loop[j].latch;
+	    }
+	}
+
+      for (k = 1; k < count; k++)
+	{
+	  int *pred = p->pred + p->pred_start[body[k]];
+	  int m = p->pred_start[body[k] + 1] - p->pred_start[body[k]];
+	  for (; m > 0; m--, pred++)
+	    if (p->block[*pred].mark != i)
+	      {
+		p->block[*pred].mark = i;
+		body[count++] = *pred;
+	      }
+	}
+
+      l->blocks = count;
+      l->instructions = l->calls = 0;
+      l->time = 0;
+      for (k = 0; k < count; k++)
+	{
+	  block = body[k];
+	  l->instructions += p->block[block].instructions;
+	  l->time += p->block[block].time;
+	  if (p->block[block].flow & FLOW_CALL)
+	    l->calls++;
+	  p->block[block].depth++;
+	}
+      n++;
+    }
+
+  p->loops = n;
+  free (body);
+}
+
+static int
+compare_loops (const void *a, const void *b)
+{
+  const struct loop *x = a, *y = b;
+  if (x->time != y->time)
+    return x->time > y->time ? -1 : 1;
+  return x->header < y->header ? -1 : x->header > y->header;
+}
+
+/* Each code label starts a routine. */
+static void
+find_routines (struct profile *p, struct pdp10_memory *memory)
+{
+  const struct symbol *sym;
+  int *start, i, n, r, size = 0;
+  word_t value;
+
+  start = NULL;
+  for (i = n = 0; i < symbol_table->count; i++)
+    {
+      value = symbol_table->symbol[i].value;
+      if (value < 020 || value >= (1 << MEMORY_ADDRESS_BITS) ||
+	  !code_word_at (memory, value))
+	continue;
+      start = grow (start, n, &size, sizeof *start);
+      start[n++] = value;
+    }
+  qsort (start, n, sizeof *start, compare_ints);
+
+  p->routine = malloc (n * sizeof *p->routine + 1);
+  if (p->routine == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  for (i = r = 0; i < n; i++)
+    {
+      if (r > 0 && p->routine[r - 1].start == start[i])
+	continue;
+      /* The same labels as in the disassembly. */
+      sym = get_symbol_by_value (start[i], HINT_ADDRESS);
+      if (sym == NULL)
+	continue;
+      p->routine[r].start = start[i];
+      p->routine[r].name = sym->name;
+      p->routine[r].blocks = p->routine[r].instructions = 0;
+      p->routine[r].loops = 0;
+      p->routine[r].time = 0;
+      r++;
+    }
+  p->routines = r;
+  free (start);
+
+  for (i = r = 0; i < p->blocks; i++)
+    {
+      while (r < p->routines && p->routine[r].start <= p->block[i].start)
+	r++;
+      p->block[i].routine = r - 1;
+      if (r == 0)
+	continue;
+      p->routine[r - 1].blocks++;
+      p->routine[r - 1].instructions += p->block[i].instructions;
+      p->routine[r - 1].time += p->block[i].time;
+    }
+}
+
+static const char *
+routine_name (const struct profile *p, int block)
+{
+  int r = p->block[block].routine;
+  if (r == -1 || p->routine[r].name == NULL)
+    return "-";
+  return p->routine[r].name;
+}
+
+static void
+print_profile (struct profile *p, const char *model)
+{
+  const struct block *b;
+  const struct routine *r;
+  const struct loop *l;
+  int i, n;
+
+  n = p->loops < PROFILE_LOOPS ? p->loops : PROFILE_LOOPS;
+
+  if (dis_format == DIS_JSON)
+    {
+      for (i = 0; i < p->blocks; i++)
+	{
+	  b = &p->block[i];
+	  fprintf (file_context->output,
+		   "{\"block\":%d,\"end\":%d,\"instructions\":%d,"
+		   "\"ns\":%lld,\"depth\":%d,\"routine\":",
+		   b->start, b->end, b->instructions, b->time, b->depth);
+	  print_json_string (file_context->output, b->routine == -1
+			     ? NULL : p->routine[b->routine].name);
+	  fputs ("}\n", file_context->output);
+	}
+      for (i = 0; i < p->routines; i++)
+	{
+	  r = &p->routine[i];
+	  fputs ("{\"routine\":", file_context->output);
+	  print_json_string (file_context->output, r->name);
+	  fprintf (file_context->output, ",\"start\":%d,\"blocks\":%d,"
+		   "\"instructions\":%d,\"ns\":%lld,\"loops\":%d}\n",
+		   r->start, r->blocks, r->instructions, r->time, r->loops);
+	}
+      for (i = 0; i < n; i++)
+	{
+	  l = &p->loop[i];
+	  fprintf (file_context->output,
+		   "{\"loop\":%d,\"latch\":%d,\"blocks\":%d,"
+		   "\"instructions\":%d,\"ns\":%lld,\"depth\":%d,"
+		   "\"calls\":%d,\"routine\":",
+		   p->block[l->header].start, p->block[l->latch].start,
+		   l->blocks, l->instructions, l->time,
+		   p->block[l->header].depth, l->calls);
+	  r = p->block[l->header].routine == -1
+	      ? NULL : &p->routine[p->block[l->header].routine];
+	  print_json_string (file_context->output, r == NULL ? NULL : r->name);
+	  fputs ("}\n", file_context->output);
+	}
+      return;
+    }
+
+  fprintf (file_context->output, "Estimated time in nanoseconds, %s timing.\n",
+	   model);
+
+  fprintf (file_context->output, "\nBasic blocks:\n\n");
+  fprintf (file_context->output,
+	   " Start    End  Instrs        ns  Depth  Routine\n");
+  for (i = 0; i < p->blocks; i++)
+    {
+      b = &p->block[i];
+      fprintf (file_context->output, "%06o %06o  %6d  %8lld  %5d  %s\n",
+	       b->start, b->end - 1, b->instructions, b->time, b->depth,
+	       routine_name (p, i));
+    }
+
+  fprintf (file_context->output, "\nRoutines:\n\n");
+  fprintf (file_context->output,
+	   "Routine    Start  Blocks  Instrs        ns  Loops\n");
+  for (i = 0; i < p->routines; i++)
+    {
+      r = &p->routine[i];
+      fprintf (file_context->output, "%-8s  %06o  %6d  %6d  %8lld  %5d\n",
+	       r->name == NULL ? "-" : r->name, r->start, r->blocks,
+	       r->instructions, r->time, r->loops);
+    }
+
+  fprintf (file_context->output, "\nMost expensive loops, per iteration:\n\n");
+  fprintf (file_context->output,
+	   "  Head  Latch  Blocks  Instrs        ns  Depth  Calls  Routine\n");
+  for (i = 0; i < n; i++)
+    {
+      l = &p->loop[i];
+      fprintf (file_context->output,
+	       "%06o %06o  %6d  %6d  %8lld  %5d  %5d  %s\n",
+	       p->block[l->header].start, p->block[l->latch].start,
+	       l->blocks, l->instructions, l->time,
+	       p->block[l->header].depth, l->calls,
+	       routine_name (p, l->header));
+    }
+}
+
+void
+profile (struct pdp10_memory *memory, int cpu_model)
+{
+  struct profile p;
+  int i, timing;
+
+  timing = (cpu_model & PDP10_KI10) ? PDP10_KI10 : PDP10_KA10;
+
+  discover_code (memory, cpu_model);
+  find_blocks (&p, memory, cpu_model, timing);
+  find_edges (&p);
+  find_dominators (&p);
+  find_loops (&p);
+  find_routines (&p, memory);
+
+  for (i = 0; i < p.loops; i++)
+    if (p.block[p.loop[i].header].routine != -1)
+      p.routine[p.block[p.loop[i].header].routine].loops++;
+  qsort (p.loop, p.loops, sizeof *p.loop, compare_loops);
+
+  print_profile (&p, timing == PDP10_KI10 ? "KI10" : "KA10");
+  fflush (file_context->output);
+
+  free (p.block);
+  free (p.routine);
+  free (p.loop);
+  free (p.pred_start);
+  free (p.pred);
+  free (p.idom);
+  free (p.post);
+}
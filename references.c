@@ -0,0 +1,180 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Reverse references: for each 18-bit address, every word in memory
+   which holds it in the right or left half.  One pass counts the
+   references to each address, and a second one fills them in, so
+   each list comes out in ascending order of referring address, with
+   the right half before the left half of the same word.
+
+   An index can also be made from references collected elsewhere, in
+   which case each list keeps the order they were added in. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "references.h"
+
+#define ADDRESSES	01000000
+
+static void *
+xmalloc (size_t size)
+{
+  void *p = malloc (size);
+  if (p == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  return p;
+}
+
+/* Call fn for each half of every word in memory. */
+static void
+each_half (struct pdp10_memory *memory,
+	   void (*fn) (struct pdp10_references *, int, int),
+	   struct pdp10_references *references)
+{
+  word_t data;
+  int i, j;
+
+  for (i = 0; i < memory->areas; i++)
+    for (j = memory->area[i].start; j < memory->area[i].end; j++)
+      {
+	data = get_word_at (memory, j);
+	if (data == -1)
+	  continue;
+	fn (references, data & 0777777, j);
+	fn (references, (data >> 18) & 0777777, j | REFERENCE_LEFT);
+      }
+}
+
+static void
+count (struct pdp10_references *references, int address, int from)
+{
+  (void)from;
+  references->start[address + 1]++;
+}
+
+static void
+fill (struct pdp10_references *references, int address, int from)
+{
+  references->reference[references->start[address]++] = from;
+}
+
+static void
+start_counting (struct pdp10_references *references)
+{
+  int i;
+
+  references->start = xmalloc ((ADDRESSES + 1) * sizeof (int));
+  for (i = 0; i <= ADDRESSES; i++)
+    references->start[i] = 0;
+}
+
+/* After counting and summing, start[a] is where the references to a
+   go.  Filling moves it to where they end, so finally shift it back
+   one step. */
+static void
+start_filling (struct pdp10_references *references)
+{
+  int i;
+
+  for (i = 1; i <= ADDRESSES; i++)
+    references->start[i] += references->start[i - 1];
+  references->reference = xmalloc (references->start[ADDRESSES] * sizeof (int)
+				   + 1);
+}
+
+static void
+end_filling (struct pdp10_references *references)
+{
+  int i;
+
+  for (i = ADDRESSES; i > 0; i--)
+    references->start[i] = references->start[i - 1];
+  references->start[0] = 0;
+}
+
+void
+build_references (struct pdp10_references *references,
+		  struct pdp10_memory *memory)
+{
+  start_counting (references);
+  each_half (memory, count, references);
+  start_filling (references);
+  each_half (memory, fill, references);
+  end_filling (references);
+}
+
+void
+add_reference (struct reference_list *list, int address, int from)
+{
+  if (list->count == list->size)
+    {
+      list->size = list->size ? 2 * list->size : 1024;
+      list->pair = realloc (list->pair, 2 * list->size * sizeof (int));
+      if (list->pair == NULL)
+	{
+	  fprintf (stderr, "Out of memory.\n");
+	  exit (1);
+	}
+    }
+
+  list->pair[2 * list->count] = address & 0777777;
+  list->pair[2 * list->count + 1] = from;
+  list->count++;
+}
+
+/* Make an index from the references in n lists, and free the lists. */
+void
+sort_references (struct pdp10_references *references,
+		 struct reference_list *lists, int n)
+{
+  int i, j;
+
+  start_counting (references);
+  for (i = 0; i < n; i++)
+    for (j = 0; j < lists[i].count; j++)
+      count (references, lists[i].pair[2 * j], 0);
+  start_filling (references);
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < lists[i].count; j++)
+	fill (references, lists[i].pair[2 * j], lists[i].pair[2 * j + 1]);
+      free (lists[i].pair);
+      lists[i].pair = NULL;
+      lists[i].count = lists[i].size = 0;
+    }
+  end_filling (references);
+}
+
+void
+free_references (struct pdp10_references *references)
+{
+  free (references->start);
+  free (references->reference);
+  references->start = NULL;
+  references->reference = NULL;
+}
+
+/* Return the references to an address, and their number in n. */
+const int *
+get_references (struct pdp10_references *references, int address, int *n)
+{
+  address &= 0777777;
+  *n = references->start[address + 1] - references->start[address];
+  return references->reference + references->start[address];
+}
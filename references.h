@@ -0,0 +1,50 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef REFERENCES_H
+#define REFERENCES_H
+
+#include "memory.h"
+
+/* Set in a reference from the left half of a word. */
+#define REFERENCE_LEFT	(1 << MEMORY_ADDRESS_BITS)
+#define REFERENCE_ADDRESS(x) ((x) & (REFERENCE_LEFT - 1))
+
+/* For each 18-bit address, the words which have it in either half. */
+struct pdp10_references
+{
+  int *start;			/* Index of the first reference. */
+  int *reference;		/* Referring word addresses. */
+};
+
+/* References collected one at a time, to be sorted into an index. */
+struct reference_list
+{
+  int *pair;			/* Address and referring word. */
+  int count;
+  int size;
+};
+
+extern void	build_references (struct pdp10_references *references,
+				  struct pdp10_memory *memory);
+extern void	add_reference (struct reference_list *list,
+			       int address, int from);
+extern void	sort_references (struct pdp10_references *references,
+				 struct reference_list *lists, int n);
+extern void	free_references (struct pdp10_references *references);
+extern const int *get_references (struct pdp10_references *references,
+				  int address, int *n);
+
+#endif /* REFERENCES_H */
@@ -231,7 +231,7 @@ read_rim10 (FILE *f, struct pdp10_memory *memory, int cpu_model)
   word_t word;
   int i;
 
-  fprintf (output_file, "RIM10 format\n");
+  fprintf (file_context->output, "RIM10 format\n");
 
   word = get_word (f);
   address = (word & 0777777) + 1;
@@ -274,13 +274,14 @@ read_rim10 (FILE *f, struct pdp10_memory *memory, int cpu_model)
     {
     case JRST:
     case JUMPA:
-      start_instruction = insn;
+      file_context->start_instruction = insn;
       break;
     default:
-      start_instruction = JRST + pc;
+      file_context->start_instruction = JRST + pc;
       break;
     }
-  fprintf (output_file, "Start instruction: %012llo\n", start_instruction);
+  fprintf (file_context->output,
+	   "Start instruction: %012llo\n", file_context->start_instruction);
 
   /* Remove IOWD. */
   remove_memory (memory, 0, 1);
@@ -297,7 +298,7 @@ write_rim10 (FILE *f, struct pdp10_memory *memory)
     write_word (f, midas_rim10[i]);
 
   write_sblk_core (f, memory, 020);
-  write_word (f, start_instruction);
+  write_word (f, file_context->start_instruction);
 }
 
 struct file_format rim10_file_format = {
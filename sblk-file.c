@@ -30,11 +30,10 @@ read_sblk (FILE *f, struct pdp10_memory *memory, int cpu_model)
 {
   int address;
   word_t word;
-  int i;
 
   int block_length, block_address;
 
-  fprintf (output_file, "SBLK format\n");
+  fprintf (file_context->output, "SBLK format\n");
 
   address = 0;
   while ((word = get_word (f)) != JRST_1)
@@ -50,7 +49,7 @@ read_sblk (FILE *f, struct pdp10_memory *memory, int cpu_model)
       
   while ((word = get_word (f)) & SIGNBIT)
     {
-      word_t *data, *ptr;
+      word_t *data;
 
       reset_checksum (word);
       block_length = -((word >> 18) | ((-1) & ~0777777));
@@ -63,11 +62,7 @@ read_sblk (FILE *f, struct pdp10_memory *memory, int cpu_model)
 	  exit (1);
 	}
 
-      ptr = data;
-      for (i = 0; i < block_length; i++)
-	{
-	  *ptr++ = get_checksummed_word (f);
-	}
+      get_checksummed_words (f, data, block_length);
 
       add_memory (memory, block_address, block_length, data);
 
@@ -75,8 +70,8 @@ read_sblk (FILE *f, struct pdp10_memory *memory, int cpu_model)
       check_checksum (word);
     }
 
-  fprintf (output_file, "\n");
-  start_instruction = word;
+  fprintf (file_context->output, "\n");
+  file_context->start_instruction = word;
   sblk_info (f, word, cpu_model);
 }
 
@@ -135,22 +130,22 @@ write_sblk_symbols (FILE *f)
   word_t word, cksum;
   int i, length;
 
-  length = 2 * num_symbols;
+  length = 2 * symbol_table->count;
   word = length;
   word = (-word) << 18;
   word &= WORDMASK;
   write_word (f, word);
 
   cksum = word;
-  for (i = 0; i < num_symbols; i++)
+  for (i = 0; i < symbol_table->count; i++)
     {
       cksum = (cksum << 1) | (cksum >> 35);
-      word = ascii_to_squoze (symbols[i].name);
-      if (symbols[i].flags & SYMBOL_KILLED)
+      word = ascii_to_squoze (symbol_table->symbol[i].name);
+      if (symbol_table->symbol[i].flags & SYMBOL_KILLED)
 	word |= SYKIL;
-      if (symbols[i].flags & SYMBOL_HALFKILLED)
+      if (symbol_table->symbol[i].flags & SYMBOL_HALFKILLED)
 	word |= SYHKL;
-      if (symbols[i].flags & SYMBOL_GLOBAL)
+      if (symbol_table->symbol[i].flags & SYMBOL_GLOBAL)
 	word |= SYGBL;
       else
 	word |= SYLCL;
@@ -159,7 +154,7 @@ write_sblk_symbols (FILE *f)
       write_word (f, word);
 
       cksum = (cksum << 1) | (cksum >> 35);
-      word = symbols[i].value;
+      word = symbol_table->symbol[i].value;
       cksum += word;
       cksum &= WORDMASK;
       write_word (f, word);
@@ -173,9 +168,9 @@ write_sblk (FILE *f, struct pdp10_memory *memory)
 {
   write_word (f, JRST_1);
   write_sblk_core (f, memory, 0);
-  write_word (f, start_instruction);
+  write_word (f, file_context->start_instruction);
   write_sblk_symbols (f);
-  write_word (f, start_instruction);
+  write_word (f, file_context->start_instruction);
 }
 
 struct file_format sblk_file_format = {
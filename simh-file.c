@@ -48,13 +48,13 @@ write_simh (FILE *f, struct pdp10_memory *memory)
     write_location (f, memory, i);
 
   /* Start. */
-  if (start_instruction <= 0)
+  if (file_context->start_instruction <= 0)
     ;
-  else if (((start_instruction & 0777000000000LL) == JRST) ||
-	   start_instruction <= 0777777)
-    fprintf (f, "go %06llo\n", start_instruction & 0777777);
+  else if (((file_context->start_instruction & 0777000000000LL) == JRST) ||
+	   file_context->start_instruction <= 0777777)
+    fprintf (f, "go %06llo\n", file_context->start_instruction & 0777777);
   else
-    fprintf (f, ";execute %012llo\n", start_instruction);
+    fprintf (f, ";execute %012llo\n", file_context->start_instruction);
 }
 
 static int
@@ -120,7 +120,7 @@ start (char *line)
   unsigned long address = strtoul (line, &p, 8);
   if (p == line || !whitespace_or_nul (*p))
     fatal ("Invalid GO argument: \"%s\"\n", line);
-  start_instruction = JRST | address;
+  file_context->start_instruction = JRST | address;
 }
 
 static void
@@ -151,10 +151,10 @@ read_line (char *line, struct pdp10_memory *memory)
 static void
 read_simh (FILE *f, struct pdp10_memory *memory, int cpu_model)
 {
-  static char line[100];
+  char line[100];
   (void)cpu_model;
 
-  fprintf (output_file, ";SIMH script\n\n");
+  fprintf (file_context->output, ";SIMH script\n\n");
 
   for (;;)
     {
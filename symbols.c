@@ -22,8 +22,6 @@
 #include "dis.h"
 #include "symbols.h"
 
-#define MAX_SYMBOLS 16384
-
 static int symbols_mode = SYMBOLS_NONE;
 
 void
@@ -47,72 +45,91 @@ parse_symbols_mode (const char *string)
   return 0;
 }
 
-struct symbol symbols[MAX_SYMBOLS];
-int num_symbols = 0;
+static struct symbol_table default_symbol_table;
+
+__thread struct symbol_table *symbol_table = &default_symbol_table;
+
+/* Symbol names are stored in a string arena, which is a list of
+   large blocks.  Names are never freed individually, only all at
+   once by free_symbols.  A name which is already present is shared
+   between symbols. */
+#define ARENA_BLOCK 65536
 
-typedef enum {
-  SORT_NONE,
-  SORT_NAME,
-  SORT_VALUE
-} sort_mode_t;
-static sort_mode_t sorted = SORT_NONE;
+struct arena_block
+{
+  struct arena_block *next;
+  size_t used, size;
+  char data[];
+};
 
 void
-add_symbol (const char *name, word_t value, int flags)
+init_symbol_table (struct symbol_table *table)
 {
-  int i = num_symbols++;
-  char *p;
+  memset (table, 0, sizeof *table);
+}
 
-  if (num_symbols > MAX_SYMBOLS)
+static void *
+xrealloc (void *ptr, size_t size)
+{
+  ptr = realloc (ptr, size);
+  if (ptr == NULL)
     {
-      fprintf (stderr, "Too many symbols\n");
+      fprintf (stderr, "Out of memory.\n");
       exit (1);
     }
+  return ptr;
+}
 
-  /* Copy the name, with trailing spaces stripped off. */
-  p = strdup (name);
-  symbols[i].name = p;
-  while (*p)
-    p++;
-  while (p > symbols[i].name && *(p - 1) == ' ')
-    *--p = '\0';
+static char *
+arena_alloc (size_t n)
+{
+  struct symbol_table *t = symbol_table;
+  struct arena_block *block = t->arena;
+  size_t size;
 
-  symbols[i].value = value;
-  symbols[i].sequence = num_symbols;
-  symbols[i].flags = flags;
+  if (block == NULL || block->used + n > block->size)
+    {
+      size = n > ARENA_BLOCK ? n : ARENA_BLOCK;
+      block = xrealloc (NULL, sizeof *block + size);
+      block->next = t->arena;
+      block->used = 0;
+      block->size = size;
+      t->arena = block;
+    }
 
-  sorted = SORT_NONE;
+  block->used += n;
+  return block->data + block->used - n;
 }
 
-/* When searching symbols, we can't assume that anything other than
-   the field we're searching for is valid, as one of the arguments
-   might be the key. */
+/* Symbols are indexed by name and by value in two hash tables.  Each
+   bucket holds the index of the first symbol in a chain, or -1.  The
+   chains are kept ordered by key, then by visibility, then by
+   declaration order, so the symbols with the same key are adjacent
+   and the preferred one comes first.  The tables are doubled when
+   they get half full. */
 
-static int
-compare_name_search (const void *a, const void *b)
+static unsigned
+hash_name (const char *name, size_t length)
 {
-  const struct symbol *sa = a;
-  const struct symbol *sb = b;
+  unsigned h = 5381;
+
+  while (length-- > 0)
+    h = (h << 5) + h + (unsigned char)*name++;
 
-  return strcmp (sa->name, sb->name);
+  return h & (symbol_table->hash_size - 1);
 }
 
-static int
-compare_value_search (const void *a, const void *b)
+static unsigned
+hash_value (word_t value)
 {
-  const struct symbol *sa = a;
-  const struct symbol *sb = b;
+  unsigned long long h = value;
 
-  if (sa->value == sb->value)
-    return 0;
-  else if (sa->value < sb->value)
-    return -1;
-  else
-    return 1;
+  h ^= h >> 17;
+  h *= 0x9E3779B97F4A7C15ULL;
+  return (h >> 32) & (symbol_table->hash_size - 1);
 }
 
-/* When sorting, all the fields are valid. Order first by the key we're
-   sorting by, then by visibility so the most visible symbols come
+/* Order symbols with the same key so the most visible symbols come
    first, then by their original declaration order. */
 
 static int
@@ -126,11 +143,8 @@ concealment (const struct symbol *s)
 }
 
 static int
-compare_default (const void *a, const void *b)
+compare_default (const struct symbol *sa, const struct symbol *sb)
 {
-  const struct symbol *sa = a;
-  const struct symbol *sb = b;
-
   int r = concealment (sa) - concealment (sb);
   if (r != 0)
     return r;
@@ -142,61 +156,185 @@ compare_default (const void *a, const void *b)
 }
 
 static int
-compare_name_sort (const void *a, const void *b)
+compare_name (const struct symbol *sa, const struct symbol *sb)
 {
-  int r = compare_name_search (a, b);
+  int r = strcmp (sa->name, sb->name);
 
   if (r == 0)
-    return compare_default (a, b);
+    return compare_default (sa, sb);
   else
     return r;
 }
 
 static int
-compare_value_sort (const void *a, const void *b)
+compare_value (const struct symbol *sa, const struct symbol *sb)
 {
-  int r = compare_value_search (a, b);
-
-  if (r == 0)
-    return compare_default (a, b);
+  if (sa->value == sb->value)
+    return compare_default (sa, sb);
+  else if (sa->value < sb->value)
+    return -1;
   else
-    return r;
+    return 1;
 }
 
 static void
-sort_by (sort_mode_t wanted)
+insert_chain (int *bucket, int *chain, int i,
+	      int (*compare) (const struct symbol *, const struct symbol *))
+{
+  int *p = bucket;
+
+  while (*p != -1 &&
+	 compare (&symbol_table->symbol[*p], &symbol_table->symbol[i]) < 0)
+    p = &chain[*p];
+
+  chain[i] = *p;
+  *p = i;
+}
+
+static void
+rehash (int size)
+{
+  struct symbol_table *t = symbol_table;
+  int i;
+
+  t->hash_size = size;
+  t->name_bucket = xrealloc (t->name_bucket, size * sizeof *t->name_bucket);
+  t->value_bucket = xrealloc (t->value_bucket, size * sizeof *t->value_bucket);
+  for (i = 0; i < size; i++)
+    t->name_bucket[i] = t->value_bucket[i] = -1;
+
+  for (i = 0; i < t->count; i++)
+    {
+      insert_chain (&t->name_bucket[hash_name (t->symbol[i].name,
+					    strlen (t->symbol[i].name))],
+		    t->name_chain, i, compare_name);
+      insert_chain (&t->value_bucket[hash_value (t->symbol[i].value)],
+		    t->value_chain, i, compare_value);
+    }
+}
+
+static int
+find_name (const char *name, size_t length)
 {
-  if (sorted != wanted)
+  struct symbol_table *t = symbol_table;
+  int i, r;
+
+  if (t->count == 0)
+    return -1;
+
+  for (i = t->name_bucket[hash_name (name, length)];
+       i != -1;
+       i = t->name_chain[i])
+    {
+      r = strncmp (t->symbol[i].name, name, length);
+      if (r == 0 && t->symbol[i].name[length] == 0)
+	return i;
+      else if (r > 0)
+	break;
+    }
+
+  return -1;
+}
+
+void
+add_symbol (const char *name, word_t value, int flags)
+{
+  struct symbol_table *t = symbol_table;
+  size_t length;
+  char *p;
+  int i;
+
+  if (t->count == t->max)
+    {
+      t->max = t->max ? 2 * t->max : 1024;
+      t->symbol = xrealloc (t->symbol, t->max * sizeof *t->symbol);
+      t->name_chain = xrealloc (t->name_chain, t->max * sizeof *t->name_chain);
+      t->value_chain = xrealloc (t->value_chain,
+				 t->max * sizeof *t->value_chain);
+      rehash (2 * t->max);
+    }
+
+  /* Find the name, with trailing spaces stripped off. */
+  length = strlen (name);
+  while (length > 0 && name[length - 1] == ' ')
+    length--;
+
+  i = find_name (name, length);
+  if (i == -1)
+    {
+      p = arena_alloc (length + 1);
+      memcpy (p, name, length);
+      p[length] = 0;
+    }
+  else
+    p = (char *)t->symbol[i].name;
+
+  i = t->count++;
+  t->symbol[i].name = p;
+  t->symbol[i].value = value;
+  t->symbol[i].sequence = t->count;
+  t->symbol[i].flags = flags;
+
+  insert_chain (&t->name_bucket[hash_name (p, length)], t->name_chain,
+		i, compare_name);
+  insert_chain (&t->value_bucket[hash_value (value)], t->value_chain,
+		i, compare_value);
+}
+
+void
+free_symbols (void)
+{
+  struct symbol_table *t = symbol_table;
+  struct arena_block *next;
+
+  while (t->arena != NULL)
     {
-      qsort (symbols, num_symbols, sizeof *symbols,
-	     wanted == SORT_NAME ? compare_name_sort : compare_value_sort);
-      sorted = wanted;
+      next = t->arena->next;
+      free (t->arena);
+      t->arena = next;
     }
+
+  free (t->symbol);
+  free (t->name_chain);
+  free (t->value_chain);
+  free (t->name_bucket);
+  free (t->value_bucket);
+  t->symbol = NULL;
+  t->name_chain = t->value_chain = t->name_bucket = t->value_bucket = NULL;
+  t->count = t->max = t->hash_size = 0;
 }
 
+/* Return the next symbol with the same value, or NULL. */
 static const struct symbol *
-hint_accumulator (const struct symbol *first, word_t value)
+next_by_value (const struct symbol *symbol)
 {
-  const struct symbol *symbol = first;
+  struct symbol_table *t = symbol_table;
+  int i = t->value_chain[symbol - t->symbol];
+
+  if (i == -1 || t->symbol[i].value != symbol->value)
+    return NULL;
+
+  return &t->symbol[i];
+}
+
+static const struct symbol *
+hint_accumulator (const struct symbol *first)
+{
+  const struct symbol *symbol;
 
   /* Look for a single-letter symbol that matches. */
-  do
+  for (symbol = first; symbol != NULL; symbol = next_by_value (symbol))
     {
       if (strlen (symbol->name) == 1)
 	return symbol;
-      symbol++;
     }
-  while (symbol < symbols + num_symbols && symbol->value == value);
 
   /* Failing that, try two-letter symbols. */
-  symbol = first;
-  do
+  for (symbol = first; symbol != NULL; symbol = next_by_value (symbol))
     {
       if (strlen (symbol->name) == 2)
 	return symbol;
-      symbol++;
     }
-  while (symbol < symbols + num_symbols && symbol->value == value);
 
   return first;
 }
@@ -205,68 +343,59 @@ static const struct symbol *
 hint_address (const struct symbol *first, word_t value)
 {
   if (value < 020)
-    return hint_accumulator (first, value);
+    return hint_accumulator (first);
 
   return first;
 }
 
 static const struct symbol *
-hint_offset (const struct symbol *first, word_t value)
+hint_offset (const struct symbol *first)
 {
-  const struct symbol *symbol = first;
+  const struct symbol *symbol;
 
   /* Look for a symbol with more than one letter. */
-  do
+  for (symbol = first; symbol != NULL; symbol = next_by_value (symbol))
     {
       if (strlen (symbol->name) > 1)
 	return symbol;
-      symbol++;
     }
-  while (symbol < symbols + num_symbols && symbol->value == value);
 
   return first;
 }
 
 static const struct symbol *
-hint_channel (const struct symbol *first, word_t value)
+hint_channel (const struct symbol *first)
 {
-  const struct symbol *symbol = first;
+  const struct symbol *symbol;
 
   /* Look for a symbol containing CH. */
-  do
+  for (symbol = first; symbol != NULL; symbol = next_by_value (symbol))
     {
       if (strstr (symbol->name, "ch"))
 	return symbol;
-      symbol++;
     }
-  while (symbol < symbols + num_symbols && symbol->value == value);
 
   /* Second try, symbols that end with C. */
-  symbol = first;
-  do
+  for (symbol = first; symbol != NULL; symbol = next_by_value (symbol))
     {
       if (symbol->name[strlen (symbol->name) - 1] == 'c')
 	return symbol;
-      symbol++;
     }
-  while (symbol < symbols + num_symbols && symbol->value == value);
 
   return first;
 }
 
 static const struct symbol *
-hint_xctr (const struct symbol *first, word_t value)
+hint_xctr (const struct symbol *first)
 {
-  const struct symbol *symbol = first;
+  const struct symbol *symbol;
 
   /* Look for matching symbol that begins with X. */
-  do
+  for (symbol = first; symbol != NULL; symbol = next_by_value (symbol))
     {
       if (*symbol->name == 'x')
 	return symbol;
-      symbol++;
     }
-  while (symbol < symbols + num_symbols && symbol->value == value);
 
   return first;
 }
@@ -274,31 +403,35 @@ hint_xctr (const struct symbol *first, word_t value)
 const struct symbol *
 get_symbol_by_value (word_t value, int hint)
 {
-  struct symbol key = { NULL, value, -1, 0 };
+  struct symbol_table *t = symbol_table;
   const struct symbol *first;
+  int i;
 
   if (symbols_mode == SYMBOLS_NONE || hint == HINT_NUMBER)
     return NULL;
 
-  sort_by (SORT_VALUE);
-  first = bsearch (&key, symbols, num_symbols, sizeof *symbols,
-		   compare_value_search);
-
-  if (first == NULL)
+  if (t->count == 0)
     return NULL;
 
-  /* Wind the pointer back to find the first symbol that matches. */
-  while (first > symbols && (first - 1)->value == value)
-    first--;
+  /* Find the first symbol that matches. */
+  for (i = t->value_bucket[hash_value (value)]; i != -1; i = t->value_chain[i])
+    {
+      if (t->symbol[i].value >= value)
+	break;
+    }
+
+  if (i == -1 || t->symbol[i].value != value)
+    return NULL;
+  first = &t->symbol[i];
 
   switch (hint)
     {
-    case HINT_ACCUMULATOR: first = hint_accumulator (first, value); break;
-    case HINT_CHANNEL:     first = hint_channel (first, value); break;
+    case HINT_ACCUMULATOR: first = hint_accumulator (first); break;
+    case HINT_CHANNEL:     first = hint_channel (first); break;
     case HINT_ADDRESS:     first = hint_address (first, value); break;
-    case HINT_OFFSET:      first = hint_offset (first, value); break;
-    case HINT_IMMEDIATE:   first = hint_offset (first, value); break;
-    case HINT_XCTR:        first = hint_xctr (first, value); break;
+    case HINT_OFFSET:      first = hint_offset (first); break;
+    case HINT_IMMEDIATE:   first = hint_offset (first); break;
+    case HINT_XCTR:        first = hint_xctr (first); break;
     }
 
   if (symbols_mode == SYMBOLS_DDT)
@@ -313,21 +446,12 @@ get_symbol_by_value (word_t value, int hint)
 const struct symbol *
 get_symbol_by_name (const char *name)
 {
-  struct symbol key = { name, 0, -1, 0 };
-  const struct symbol *first;
-
-  sort_by (SORT_NAME);
-  first = bsearch (&key, symbols, num_symbols, sizeof *symbols,
-		   compare_name_search);
+  int i = find_name (name, strlen (name));
 
-  if (first == NULL)
+  if (i == -1)
     return NULL;
 
-  /* Wind the pointer back to find the first symbol that matches. */
-  while (first > symbols && strcmp ((first - 1)->name, name) == 0)
-    first--;
-
-  return first;
+  return &symbol_table->symbol[i];
 }
 
 word_t
@@ -22,6 +22,7 @@
 #define SYMBOL_GLOBAL       (1 << 0)
 #define SYMBOL_HALFKILLED   (1 << 1)
 #define SYMBOL_KILLED       (1 << 2)
+#define SYMBOL_CODE         (1 << 3)	/* Known to be an entry point. */
 
 /* Hints for what kind of symbol is desired. */
 typedef enum {
@@ -46,11 +47,25 @@ struct symbol
   /* XXX struct symbol *next; for multiple results? */
 };
 
+/* A table of symbols, indexed by name and by value.  Each thread has
+   a current table, which starts out as a shared default. */
+struct symbol_table
+{
+  struct symbol *symbol;
+  int count, max;
+  struct arena_block *arena;
+  int hash_size;
+  int *name_bucket, *value_bucket;
+  int *name_chain, *value_chain;
+};
+
+extern __thread struct symbol_table *symbol_table;
+
+extern void init_symbol_table (struct symbol_table *table);
 extern void add_symbol (const char *name, word_t value, int flags);
 extern const struct symbol *get_symbol_by_name (const char *name);
 extern const struct symbol *get_symbol_by_value (word_t value, int hint);
 extern word_t get_symbol_value (const char *name);
-extern struct symbol symbols[];
-extern int num_symbols;
+extern void free_symbols (void);
 
 #endif
@@ -14,25 +14,123 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
 
 #include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "tape-image.h"
 
-static int big_endian = 0;
+static void
+tape_image_error (struct tape_image *t, const char *format, ...)
+{
+  va_list ap;
+
+  va_start (ap, format);
+  if (t->error == NULL)
+    {
+      vprintf (format, ap);
+      exit (1);
+    }
+  vsnprintf (t->message, sizeof t->message, format, ap);
+  va_end (ap);
+  longjmp (*t->error, 1);
+}
 
 static void
-read_octets (uint8_t *buffer, int n)
+read_octets (struct tape_image *t, uint8_t *buffer, size_t n)
 {
-  int c, i;
+  int c;
+  size_t i;
+
+  if (t->map != NULL || t->file == NULL)
+    {
+      if (n > t->size - t->position)
+        tape_image_error (t, "Error reading tape image\n");
+      memcpy (buffer, t->map + t->position, n);
+      t->position += n;
+      return;
+    }
 
   for (i = 0; i < n; i++)
     {
-      c = getchar ();
+      c = getc (t->file);
       if (c == EOF)
+        tape_image_error (t, "Error reading tape image\n");
+      *buffer++ = c;
+    }
+  t->position += n;
+}
+
+void
+open_tape_image (struct tape_image *t, FILE *f)
+{
+  memset (t, 0, sizeof *t);
+  t->file = f;
+}
+
+/* Map a tape image file.  Only the parts which are read are brought
+   in from the file. */
+int
+map_tape_image (struct tape_image *t, const char *name)
+{
+  struct stat st;
+  void *map;
+  int fd;
+
+  memset (t, 0, sizeof *t);
+  fd = open (name, O_RDONLY);
+  if (fd == -1)
+    return -1;
+  if (fstat (fd, &st) == -1)
+    {
+      close (fd);
+      return -1;
+    }
+
+  if (st.st_size > 0)
+    {
+      map = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED)
         {
-          printf ("Error reading tape image\n");
-          exit (1);
+          close (fd);
+          return -1;
         }
-      *buffer++ = c;
+      t->map = map;
+      t->size = st.st_size;
     }
+
+  close (fd);
+  return 0;
+}
+
+void
+close_tape_image (struct tape_image *t)
+{
+  if (t->map != NULL)
+    munmap ((void *)t->map, t->size);
+  t->map = NULL;
+}
+
+/* Skip to the end of the image, and return the number of octets
+   skipped. */
+size_t
+skip_tape_image (struct tape_image *t)
+{
+  size_t n = 0;
+
+  if (t->map != NULL || t->file == NULL)
+    {
+      n = t->size - t->position;
+      t->position = t->size;
+      return n;
+    }
+
+  while (getc (t->file) != EOF)
+    n++;
+  t->position += n;
+  return n;
 }
 
 static uint32_t
@@ -57,23 +155,23 @@ read_32bits_l (uint8_t *start)
 }
 
 static uint32_t
-read_reclen (uint8_t *start)
+read_reclen (struct tape_image *t, uint8_t *start)
 {
   uint32_t x;
   x = read_32bits_l (start);
-  if (big_endian)
+  if (t->big_endian)
     x = swap (x);
   return x;
 }
 
 uint32_t
-read_record (FILE *f, uint8_t *buffer, uint32_t n)
+read_record (struct tape_image *t, uint8_t *buffer, uint32_t n)
 {
   uint8_t size[5];
   uint32_t len, len2;
 
-  read_octets (size, 4);
-  len = read_reclen (size);
+  read_octets (t, size, 4);
+  len = read_reclen (t, size);
   if (len == 0)
     return len;
   if (len == 0xFFFFFFFF)
@@ -84,40 +182,38 @@ read_record (FILE *f, uint8_t *buffer, uint32_t n)
   if (len > 100000)
     {
       len = swap (len);
-      big_endian = !big_endian;
+      t->big_endian = !t->big_endian;
     }
 
   if ((len & 0x80000000) != 0)
     return len;
   if (len > 100000)
     {
-      printf ("Bad record size: %u %x\n", len, len);
-      exit (1);
+      tape_image_error (t, "Bad record size: %u %x\n", len, len);
     }
 
   if (len > 0)
     {
       if (len > n)
         {
-          printf ("Buffer too small.\n");
-          exit (1);
+          tape_image_error (t, "Buffer too small.\n");
         }
 
-      read_octets (buffer, len);
-      read_octets (size, 4);
-      len2 = read_reclen (size);
+      read_octets (t, buffer, len);
+      read_octets (t, size, 4);
+      len2 = read_reclen (t, size);
       if (len != len2)
         {
           if (len & 1) {
-            read_octets (size + 4, 1);
-            len2 = read_reclen (size + 1);
+            read_octets (t, size + 4, 1);
+            len2 = read_reclen (t, size + 1);
           }
           if (len != len2)
             {
-              printf ("Size mismatch\n");
-              printf ("Record size: %u %x\n", len, len);
-              printf ("Second size: %u %x\n", len2, len2);
-              exit (1);
+              tape_image_error (t, "Size mismatch\n"
+                                "Record size: %u %x\n"
+                                "Second size: %u %x\n",
+                                len, len, len2, len2);
             }
         }
     }
@@ -15,6 +15,21 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <setjmp.h>
 
-extern uint32_t read_record (FILE *f, uint8_t *buffer, uint32_t n);
+struct tape_image
+{
+  FILE *file;			/* Read from a stream, or */
+  const uint8_t *map;		/* from a mapped image. */
+  size_t size;
+  size_t position;		/* Octets read so far. */
+  int big_endian;
+  jmp_buf *error;		/* If set, errors jump here */
+  char message[100];		/* with a message. */
+};
 
+extern void open_tape_image (struct tape_image *t, FILE *f);
+extern int map_tape_image (struct tape_image *t, const char *name);
+extern void close_tape_image (struct tape_image *t);
+extern uint32_t read_record (struct tape_image *t, uint8_t *buffer, uint32_t n);
+extern size_t skip_tape_image (struct tape_image *t);
@@ -0,0 +1,210 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Index of the files on a tape image, kept in a sidecar file.  Each
+   file is recorded with the position in the image of its first record,
+   and the record number.  The first line identifies the tape image by
+   size and modification time, and the last line marks the index as
+   complete, so that a stale or partial index is ignored.  The lines
+   in between are
+
+     <offset> <record> <name>  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "tape-index.h"
+
+#define INDEX_MAGIC "TAPE-INDEX 1"
+#define INDEX_END "END"
+
+static void
+tape_stamp (FILE *tape, long long *size, long long *mtime)
+{
+  struct stat st;
+
+  if (fstat (fileno (tape), &st) == -1)
+    *size = *mtime = -1;
+  else
+    {
+      *size = st.st_size;
+      *mtime = st.st_mtime;
+    }
+}
+
+static int
+compare_entries (const void *a, const void *b)
+{
+  const struct tape_index_entry *x = a, *y = b;
+  int n = strcmp (x->name, y->name);
+  if (n != 0)
+    return n;
+  return x->offset < y->offset ? -1 : x->offset > y->offset;
+}
+
+static void
+add_entry (struct tape_index *index, const char *name,
+	   long offset, unsigned long record)
+{
+  struct tape_index_entry *e;
+
+  if (index->count == index->size)
+    {
+      index->size = index->size ? 2 * index->size : 100;
+      index->entry = realloc (index->entry,
+			      index->size * sizeof *index->entry);
+      if (index->entry == NULL)
+	{
+	  fprintf (stderr, "Out of memory.\n");
+	  exit (1);
+	}
+    }
+
+  e = &index->entry[index->count++];
+  e->name = strdup (name);
+  e->offset = offset;
+  e->record = record;
+  if (e->name == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+}
+
+/* Read an index file for a tape image.  Return -1 if the index
+   doesn't exist or doesn't match the image. */
+int
+read_tape_index (struct tape_index *index, const char *name, FILE *tape)
+{
+  long long size, mtime, index_size, index_mtime;
+  unsigned long record;
+  char line[1000], *p;
+  int complete = 0;
+  long offset;
+  int n;
+  FILE *f;
+
+  index->entry = NULL;
+  index->count = index->size = 0;
+
+  f = fopen (name, "r");
+  if (f == NULL)
+    return -1;
+
+  tape_stamp (tape, &size, &mtime);
+  if (fgets (line, sizeof line, f) == NULL ||
+      strncmp (line, INDEX_MAGIC " ", strlen (INDEX_MAGIC) + 1) != 0 ||
+      sscanf (line + strlen (INDEX_MAGIC), "%lld %lld",
+	      &index_size, &index_mtime) != 2 ||
+      index_size != size || index_mtime != mtime)
+    {
+      fclose (f);
+      return -1;
+    }
+
+  while (fgets (line, sizeof line, f) != NULL)
+    {
+      p = strchr (line, '\n');
+      if (p != NULL)
+	*p = 0;
+      if (strcmp (line, INDEX_END) == 0)
+	{
+	  complete = 1;
+	  break;
+	}
+      if (sscanf (line, "%ld %lu %n", &offset, &record, &n) != 2)
+	break;
+      add_entry (index, line + n, offset, record);
+    }
+  fclose (f);
+
+  if (!complete)
+    {
+      for (n = 0; n < index->count; n++)
+	free (index->entry[n].name);
+      free (index->entry);
+      index->entry = NULL;
+      index->count = index->size = 0;
+      return -1;
+    }
+
+  qsort (index->entry, index->count, sizeof *index->entry, compare_entries);
+  return 0;
+}
+
+/* Find the first file on the tape with a name.  Any other files with
+   the same name follow it. */
+const struct tape_index_entry *
+find_tape_index (const struct tape_index *index, const char *name)
+{
+  int low = 0, high = index->count, middle;
+
+  while (low < high)
+    {
+      middle = (low + high) / 2;
+      if (strcmp (index->entry[middle].name, name) < 0)
+	low = middle + 1;
+      else
+	high = middle;
+    }
+
+  if (low < index->count && strcmp (index->entry[low].name, name) == 0)
+    return &index->entry[low];
+  return NULL;
+}
+
+FILE *
+create_tape_index (const char *name, FILE *tape)
+{
+  long long size, mtime;
+  FILE *f;
+
+  f = fopen (name, "w");
+  if (f == NULL)
+    {
+      fprintf (stderr, "Error creating index %s.\n", name);
+      exit (1);
+    }
+
+  tape_stamp (tape, &size, &mtime);
+  fprintf (f, INDEX_MAGIC " %lld %lld\n", size, mtime);
+  return f;
+}
+
+void
+add_tape_index (FILE *index, const char *name,
+		long offset, unsigned long record)
+{
+  if (offset < 0)
+    {
+      fprintf (stderr, "Can't index a tape which isn't a seekable file.\n");
+      exit (1);
+    }
+
+  fprintf (index, "%ld %lu %s\n", offset, record, name);
+}
+
+void
+finish_tape_index (FILE *index)
+{
+  fputs (INDEX_END "\n", index);
+  if (fclose (index) != 0)
+    {
+      fprintf (stderr, "Error writing index.\n");
+      exit (1);
+    }
+}
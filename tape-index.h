@@ -0,0 +1,39 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <stdio.h>
+
+struct tape_index_entry
+{
+  char *name;
+  long offset;
+  unsigned long record;
+};
+
+struct tape_index
+{
+  struct tape_index_entry *entry;
+  int count;
+  int size;
+};
+
+extern int read_tape_index (struct tape_index *index, const char *name,
+			    FILE *tape);
+extern const struct tape_index_entry *
+find_tape_index (const struct tape_index *index, const char *name);
+extern FILE *create_tape_index (const char *name, FILE *tape);
+extern void add_tape_index (FILE *index, const char *name,
+			    long offset, unsigned long record);
+extern void finish_tape_index (FILE *index);
@@ -60,14 +60,11 @@ get_block (int block)
 static int
 read_block (FILE *f, word_t *buffer, int size)
 {
-  int i;
-  for (i = 0; i < size; i++)
-    {
-      if ((buffer[i] = get_word (f)) == -1)
-	break;
-      buffer[i] &= 0777777777777LL;
-    }
-  return i;
+  int i, n;
+  n = get_words (f, buffer, size);
+  for (i = 0; i < n; i++)
+    buffer[i] &= 0777777777777LL;
+  return n;
 }
 
 static void
@@ -454,7 +451,7 @@ core_size (FILE *f)
 {
   struct pdp10_memory memory;
   init_memory (&memory);
-  input_file_format->read (f, &memory, 0);
+  file_context->input_format->read (f, &memory, 0);
   rewind_word (f);
   return memory.area[memory.areas-1].end - memory.area[0].start;
 }
@@ -581,13 +578,13 @@ main (int argc, char **argv)
   int opt;
 
   image_file = NULL;
-  input_file_format = &csave_file_format;
-  input_word_format = &dta_word_format;
-  output_word_format = &aa_word_format;
+  file_context->input_format = &csave_file_format;
+  word_context->input_format = &dta_word_format;
+  word_context->output_format = &aa_word_format;
   start_alloc = start_default;
   verbose = 0;
 
-  output_file = fopen ("/dev/null", "w");
+  file_context->output = fopen ("/dev/null", "w");
 
   while ((opt = getopt (argc, argv, "vc:t:x:W:L:b:T")) != -1)
     {
@@ -648,9 +645,9 @@ main (int argc, char **argv)
 
   if (create)
     {
-      struct word_format *tmp = input_word_format;
-      input_word_format = output_word_format;
-      output_word_format = tmp;
+      struct word_format *tmp = word_context->input_format;
+      word_context->input_format = word_context->output_format;
+      word_context->output_format = tmp;
 
       memset (image, 0, sizeof image);
       memset (block_area, 0, sizeof block_area);
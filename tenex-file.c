@@ -90,13 +90,13 @@ read_tenex (FILE *f, struct pdp10_memory *memory, int cpu_model)
       exit (1);
     }
 
-  fprintf (output_file, "TENEX format\n\n");
+  fprintf (file_context->output, "TENEX format\n\n");
 
   count = RH (word);
   memset (map, 0, sizeof map);
 
-  fprintf (output_file, "Page map:\n");
-  fprintf (output_file, "File Page  Memory Page  Access\n");
+  fprintf (file_context->output, "Page map:\n");
+  fprintf (file_context->output, "File Page  Memory Page  Access\n");
   for (i = 0; i < count; i++)
     {
       word = get_word (f);
@@ -108,24 +108,24 @@ read_tenex (FILE *f, struct pdp10_memory *memory, int cpu_model)
 	  access &= ~0400000LL;
 	  access |= PAGE_COPY;
 	}
-      fprintf (output_file, "%06llo     %03llo          %06o ",
+      fprintf (file_context->output, "%06llo     %03llo          %06o ",
 	       RH (word), LH (word) & 0777, access);
 
       if (RH (word) > end)
 	end = RH (word);
 
-      fprintf (output_file, access & PAGE_READ ?  "r" : "-");
-      fprintf (output_file, access & PAGE_WRITE ? "w" : "-");
-      fprintf (output_file, access & PAGE_XCT ?   "x" : "-");
-      fprintf (output_file, access & PAGE_TRAP ?  "t" : "-");
-      fprintf (output_file, access & PAGE_COPY ?  "c" : "-");
-      fprintf (output_file, access & PAGE_ACCESS ?"a" : "-");
-      fprintf (output_file, "\n");
+      fprintf (file_context->output, access & PAGE_READ ?  "r" : "-");
+      fprintf (file_context->output, access & PAGE_WRITE ? "w" : "-");
+      fprintf (file_context->output, access & PAGE_XCT ?   "x" : "-");
+      fprintf (file_context->output, access & PAGE_TRAP ?  "t" : "-");
+      fprintf (file_context->output, access & PAGE_COPY ?  "c" : "-");
+      fprintf (file_context->output, access & PAGE_ACCESS ?"a" : "-");
+      fprintf (file_context->output, "\n");
     }
 
-  start_instruction = get_word (f);
-  fprintf (output_file, "Start instruction:\n");
-  disassemble_word (NULL, start_instruction, -1, cpu_model);
+  file_context->start_instruction = get_word (f);
+  fprintf (file_context->output, "Start instruction:\n");
+  disassemble_word (NULL, file_context->start_instruction, -1, cpu_model);
 
   /* The rest of the first two pages are unused. */
   for (i = 0; i < 2 * PAGESIZE - count - 2; i++)
@@ -153,11 +153,11 @@ static void
 write_symbols (FILE *f)
 {
   int i;
-  for (i = 0; i < num_symbols; i++)
+  for (i = 0; i < symbol_table->count; i++)
     {
-      word_t word = ascii_to_squoze (symbols[i].name);
+      word_t word = ascii_to_squoze (symbol_table->symbol[i].name);
       write_word (f, word);
-      write_word (f, symbols[i].value);
+      write_word (f, symbol_table->symbol[i].value);
     }
 }
 
@@ -221,7 +221,7 @@ write_tenex (FILE *f, struct pdp10_memory *memory)
     }
 
   /* Start instruction. */
-  write_word (f, start_instruction);
+  write_word (f, file_context->start_instruction);
 
   /* The rest of the first two pages is unused. */
   for (i = 0; i < 2 * PAGESIZE - n - 2; i++)
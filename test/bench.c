@@ -0,0 +1,299 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Time the hot paths: word format decoding, file format loading,
+   disassembly, and symbol lookup.  Run from the top directory, since
+   the samples are used.  Results are printed as words, or lookups,
+   per second. */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../dis.h"
+#include "../memory.h"
+#include "../symbols.h"
+#include "../opcode/pdp10.h"
+
+/* Synthetic data sizes. */
+#define WORDS (1024 * 1024)
+#define IMAGE 01000000
+#define SYMBOLS 10000
+#define LOOKUPS 1000000
+
+/* Spend at least this long on each sample file. */
+#define MIN_SECONDS 0.2
+
+static FILE *report;
+
+static const char *word_formats[] = {
+  "ascii", "alto", "bin", "cadr", "core", "data8", "dta", "its",
+  "oct", "pt", "sail", NULL
+};
+
+static struct {
+  const char *sample;
+  const char *file_format;
+  const char *word_format;
+  const char *machine;
+} samples[] = {
+  { "ts.srccom",  "pdump",  "its",   "ka10_its" },
+  { "@.its",      "sblk",   "its",   "ka10_its" },
+  { "its.bin",    "sblk",   "its",   "kl10_its" },
+  { "its.rp06",   "sblk",   "its",   "ks10_its" },
+  { "system.dmp", "dmp",    "oct",   "ka10sail" },
+  { "dart.dmp",   "dmp",    "data8", "ka10sail" },
+  { "macro.low",  "raw",    "ascii", "ka10" },
+  { "pt.rim",     "rim10",  "pt",    "ka10its" },
+  { "srccom.exe", "exe",    "ascii", "ka10" },
+  { "boot.exb",   "exb",    "ascii", "kl10" },
+  { "cerber.sav", "csave",  "ascii", "ka10" },
+  { "eftp.sav",   "tenex",  "alto",  "ka10" },
+  { "supdup.bin", "cross",  "its",   "ka10_its" },
+  { "logo.ptp",   "hex",    "its",   "ka10_its" },
+  { "l.bin",      "palx",   "its",   "ka10_its" },
+  { NULL, NULL, NULL, NULL }
+};
+
+static word_t seed = 1;
+
+static word_t rand36 (void)
+{
+  seed = (seed * 6364136223846793005ULL + 1442695040888963407ULL);
+  return (seed >> 20) & WORDMASK;
+}
+
+static double now (void)
+{
+  struct timespec t;
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static void result (const char *what, const char *name, double n, double t)
+{
+  fprintf (report, "%-10s %-20s %12.0f/s\n", what, name, t > 0 ? n / t : 0);
+  fflush (report);
+}
+
+static void bench_word_format (const char *name, word_t *words)
+{
+  static word_t buffer[WORDS];
+  double t;
+  size_t n;
+  FILE *f;
+  int i;
+
+  parse_input_word_format (name);
+  parse_output_word_format (name);
+  if (word_context->input_format->get_word == NULL ||
+      word_context->output_format->write_word == NULL)
+    return;
+
+  f = tmpfile ();
+  if (f == NULL)
+    {
+      fprintf (stderr, "Error creating temporary file.\n");
+      exit (1);
+    }
+  /* Text formats can't store the low bit. */
+  for (i = 0; i < WORDS; i++)
+    write_word (f, words[i] & ~1LL);
+  flush_word (f);
+
+  rewind_word (f);
+  t = now ();
+  for (n = 0; get_word (f) != -1; n++)
+    ;
+  result ("get_word", name, n, now () - t);
+
+  rewind_word (f);
+  t = now ();
+  n = get_words (f, buffer, WORDS);
+  result ("get_words", name, n, now () - t);
+
+  if (map_word_input (f) == 0)
+    {
+      rewind_word (f);
+      t = now ();
+      n = get_words (f, buffer, WORDS);
+      result ("mapped", name, n, now () - t);
+      unmap_word_input (f);
+    }
+
+  fclose (f);
+}
+
+static int count_words (struct pdp10_memory *memory)
+{
+  int i, n = 0;
+  for (i = 0; i < memory->areas; i++)
+    n += memory->area[i].end - memory->area[i].start;
+  return n;
+}
+
+static void bench_file_format (int i)
+{
+  struct pdp10_memory memory;
+  char path[100];
+  double t, words = 0;
+  int cpu_model, fd;
+  FILE *f;
+
+  snprintf (path, sizeof path, "samples/%s", samples[i].sample);
+  f = fopen (path, "rb");
+  if (f == NULL)
+    {
+      fprintf (stderr, "Error opening %s.\n", path);
+      exit (1);
+    }
+
+  parse_input_file_format (samples[i].file_format);
+  parse_input_word_format (samples[i].word_format);
+  parse_machine (samples[i].machine, &cpu_model);
+
+  /* Some loaders are chatty on stderr too. */
+  fflush (stderr);
+  fd = dup (2);
+  freopen ("/dev/null", "w", stderr);
+
+  t = now ();
+  do
+    {
+      rewind_word (f);
+      init_memory (&memory);
+      file_context->input_format->read (f, &memory, cpu_model);
+      words += count_words (&memory);
+      free_memory (&memory);
+      free_symbols ();
+    }
+  while (now () - t < MIN_SECONDS);
+  t = now () - t;
+
+  fflush (stderr);
+  dup2 (fd, 2);
+  close (fd);
+  result ("load", samples[i].sample, words, t);
+
+  fclose (f);
+}
+
+static void bench_disassembly (word_t *words)
+{
+  struct pdp10_memory memory;
+  word_t *data;
+  double t;
+  int i;
+
+  init_memory (&memory);
+  data = malloc (IMAGE * sizeof (word_t));
+  if (data == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  memcpy (data, words, IMAGE * sizeof (word_t));
+  add_memory (&memory, 0, IMAGE, data);
+
+  t = now ();
+  for (i = 0; i < IMAGE; i++)
+    disassemble_word (&memory, words[i], i, PDP10_KL10_ITS);
+  result ("dis", "disassemble_word", IMAGE, now () - t);
+
+  t = now ();
+  dis (&memory, PDP10_KA10_ITS);
+  result ("dis", "image", IMAGE, now () - t);
+
+  /* The same, but with symbols to look up. */
+  parse_symbols_mode ("all");
+  for (i = 0; i < SYMBOLS; i++)
+    {
+      char name[7];
+      sprintf (name, "S%05d", i);
+      add_symbol (name, (i * 37) % IMAGE, 0);
+    }
+  t = now ();
+  dis (&memory, PDP10_KA10_ITS);
+  result ("dis", "image with symbols", IMAGE, now () - t);
+
+  free_symbols ();
+  free_memory (&memory);
+}
+
+static void bench_symbols (void)
+{
+  char name[7];
+  double t;
+  int i;
+
+  parse_symbols_mode ("all");
+  t = now ();
+  for (i = 0; i < SYMBOLS; i++)
+    {
+      sprintf (name, "S%05d", i);
+      add_symbol (name, (i * 37) % IMAGE, 0);
+    }
+  result ("symbols", "add_symbol", SYMBOLS, now () - t);
+
+  t = now ();
+  for (i = 0; i < LOOKUPS; i++)
+    get_symbol_by_value (rand36 () % IMAGE, HINT_ADDRESS);
+  result ("symbols", "by value", LOOKUPS, now () - t);
+
+  t = now ();
+  for (i = 0; i < LOOKUPS; i++)
+    {
+      sprintf (name, "S%05d", i % (2 * SYMBOLS));
+      get_symbol_by_name (name);
+    }
+  result ("symbols", "by name", LOOKUPS, now () - t);
+
+  free_symbols ();
+}
+
+int main (void)
+{
+  word_t *words;
+  int i;
+
+  /* The disassembler and the loaders print to stdout. */
+  report = fdopen (dup (1), "w");
+  if (report == NULL || freopen ("/dev/null", "w", stdout) == NULL)
+    {
+      fprintf (stderr, "Error redirecting output.\n");
+      exit (1);
+    }
+  file_context->output = stdout;
+
+  words = malloc (WORDS * sizeof (word_t));
+  if (words == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+  for (i = 0; i < WORDS; i++)
+    words[i] = rand36 ();
+
+  for (i = 0; word_formats[i] != NULL; i++)
+    bench_word_format (word_formats[i], words);
+
+  for (i = 0; samples[i].sample != NULL; i++)
+    bench_file_format (i);
+
+  bench_disassembly (words);
+  bench_symbols ();
+
+  return 0;
+}
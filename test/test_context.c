@@ -0,0 +1,157 @@
+/* Copyright (C) 2026 Lars Brinkhoff <lars@nocrew.org>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../dis.h"
+#include "../symbols.h"
+#include "../opcode/pdp10.h"
+
+/* Run two threads at the same time, each with its own word, symbol,
+   and file contexts, and check that neither sees the state of the
+   other.  Each writes and reads back words in a different word
+   format, and disassembles the same instruction with its own name for
+   the address. */
+
+#define WORDS 1000
+#define ROUNDS 100
+
+struct test
+{
+  const char *format;
+  const char *label;
+  int failed;
+  pthread_t thread;
+};
+
+static word_t rand36 (unsigned *seed)
+{
+  int i;
+  word_t x = 0;
+
+  for (i = 0; i < 36; i++)
+    x ^= (word_t)rand_r (seed) << i;
+
+  return x & WORDMASK;
+}
+
+static void fail (struct test *t, const char *what, int i)
+{
+  printf ("FAIL: context %s %s at %d\n", t->format, what, i);
+  t->failed = 1;
+}
+
+static void round_trip (struct test *t, unsigned *seed)
+{
+  word_t words[WORDS], buffer[WORDS + 1];
+  size_t n;
+  FILE *f;
+  int i;
+
+  for (i = 0; i < WORDS; i++)
+    words[i] = rand36 (seed);
+
+  f = tmpfile ();
+  parse_output_word_format (t->format);
+  for (i = 0; i < WORDS; i++)
+    write_word (f, words[i]);
+  flush_word (f);
+
+  parse_input_word_format (t->format);
+  rewind_word (f);
+  n = get_words (f, buffer, WORDS);
+  if (n != WORDS)
+    fail (t, "words", n);
+  for (i = 0; i < (int)n; i++)
+    if ((buffer[i] & WORDMASK) != words[i])
+      fail (t, "words", i);
+
+  fclose (f);
+}
+
+static void disassemble (struct test *t, int round)
+{
+  char text[200];
+  size_t n;
+  FILE *f;
+
+  f = tmpfile ();
+  file_context->output = f;
+  /* MOVE 1,100 */
+  disassemble_word (NULL, 0200040000100LL, -1, PDP10_KA10);
+  rewind (f);
+  n = fread (text, 1, sizeof text - 1, f);
+  text[n] = 0;
+  if (strstr (text, t->label) == NULL)
+    fail (t, "symbol", round);
+  fclose (f);
+  file_context->output = NULL;
+}
+
+static void *run (void *arg)
+{
+  struct test *t = arg;
+  struct word_context words;
+  struct symbol_table symbols;
+  struct file_context file;
+  unsigned seed = 36;
+  int i;
+
+  init_word_context (&words);
+  init_symbol_table (&symbols);
+  init_file_context (&file);
+  word_context = &words;
+  symbol_table = &symbols;
+  file_context = &file;
+
+  add_symbol (t->label, 0100, 0);
+  for (i = 0; i < ROUNDS; i++)
+    {
+      round_trip (t, &seed);
+      disassemble (t, i);
+    }
+
+  free_symbols ();
+  free_word_context (&words);
+  return NULL;
+}
+
+int main (void)
+{
+  struct test test[2] = {
+    { "core", "alpha", 0, 0 },
+    { "its", "beta", 0, 0 }
+  };
+  int i, failed = 0;
+
+  parse_symbols_mode ("all");
+  for (i = 0; i < 2; i++)
+    if (pthread_create (&test[i].thread, NULL, run, &test[i]) != 0)
+      {
+	fprintf (stderr, "Error creating thread.\n");
+	exit (1);
+      }
+  for (i = 0; i < 2; i++)
+    {
+      pthread_join (test[i].thread, NULL);
+      failed |= test[i].failed;
+    }
+
+  if (!failed)
+    printf ("OK: context\n");
+  return failed;
+}
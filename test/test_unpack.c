@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "libword.h"
+
+#define WORDMASK	(0777777777777LL)
+
+/* Check the bulk word decoders against the plain C unpacking code and
+   against the word writers.  The its format has no kernels, but its
+   bulk decoder is checked against its writer. */
+
+#define WORDS 1000
+
+static const char *kernels[] = { "avx2", "sse", NULL };
+static int failed = 0;
+
+static word_t rand36 (void)
+{
+  int i;
+  word_t x = 0;
+
+  for (i = 0; i < 36; i++)
+    x ^= (word_t)rand() << i;
+
+  return x & WORDMASK;
+}
+
+static void fail (const char *what, const char *kernel, int i)
+{
+  printf ("FAIL: unpack %s %s at %d\n", what, kernel, i);
+  failed = 1;
+}
+
+/* Unpack random octets, including garbage which no writer would
+   produce, with both a vector kernel and the scalar kernel. */
+static void compare_kernel (const char *kernel)
+{
+  static unsigned char octets[9 * WORDS];
+  static word_t expected[2 * WORDS], actual[2 * WORDS];
+  int i, n;
+
+  for (i = 0; i < (int)sizeof octets; i++)
+    octets[i] = rand ();
+
+  for (n = 0; n < WORDS; n += 1 + n / 8)
+    {
+      select_unpack_kernel ("scalar");
+      unpack_core (octets, expected, n);
+      select_unpack_kernel (kernel);
+      unpack_core (octets, actual, n);
+      for (i = 0; i < n; i++)
+	if (actual[i] != expected[i])
+	  fail ("core", kernel, i);
+
+      select_unpack_kernel ("scalar");
+      unpack_bin (octets, expected, n / 2);
+      select_unpack_kernel (kernel);
+      unpack_bin (octets, actual, n / 2);
+      for (i = 0; i < 2 * (n / 2); i++)
+	if (actual[i] != expected[i])
+	  fail ("bin", kernel, i);
+
+      select_unpack_kernel ("scalar");
+      unpack_dta (octets, expected, n);
+      select_unpack_kernel (kernel);
+      unpack_dta (octets, actual, n);
+      for (i = 0; i < n; i++)
+	if (actual[i] != expected[i])
+	  fail ("dta", kernel, i);
+    }
+}
+
+/* Write random words in a word format, and read them back with
+   get_words. */
+static void round_trip (const char *format, const char *kernel)
+{
+  word_t words[WORDS], buffer[WORDS + 1];
+  size_t n;
+  FILE *f;
+  int i;
+
+  for (i = 0; i < WORDS; i++)
+    words[i] = rand36 ();
+
+  f = tmpfile ();
+  parse_output_word_format (format);
+  for (i = 0; i < WORDS; i++)
+    write_word (f, words[i]);
+  flush_word (f);
+
+  parse_input_word_format (format);
+  select_unpack_kernel (kernel);
+  rewind_word (f);
+  n = get_words (f, buffer, WORDS);
+  if (n != WORDS)
+    fail (format, kernel, n);
+  for (i = 0; i < (int)n; i++)
+    if ((buffer[i] & WORDMASK) != words[i])
+      fail (format, kernel, i);
+
+  fclose (f);
+}
+
+int main (void)
+{
+  const char **kernel;
+
+  srand (36);
+
+  round_trip ("core", "scalar");
+  round_trip ("bin", "scalar");
+  round_trip ("dta", "scalar");
+  round_trip ("its", "scalar");
+
+  for (kernel = kernels; *kernel != NULL; kernel++)
+    {
+      if (select_unpack_kernel (*kernel) != 0)
+	continue;
+      compare_kernel (*kernel);
+      round_trip ("core", *kernel);
+      round_trip ("bin", *kernel);
+      round_trip ("dta", *kernel);
+    }
+
+  if (!failed)
+    printf ("OK: unpack\n");
+  return failed;
+}
@@ -463,6 +463,12 @@ process_user (FILE *f, word_t word)
     }
 }
 
+static void
+report (void)
+{
+  report_tape_rate (info);
+}
+
 static void
 process_saveset (FILE *f)
 {
@@ -491,8 +497,8 @@ main (int argc, char **argv)
   FILE *f = NULL;
   int opt;
 
-  input_word_format = &tape_word_format;
-  output_word_format = &aa_word_format;
+  word_context->input_format = &tape_word_format;
+  word_context->output_format = &aa_word_format;
 
   if (argc == 1)
     usage (argv[0]);
@@ -525,7 +531,7 @@ main (int argc, char **argv)
 	  extract = 1;
 	  break;
 	case '7':
-	  input_word_format = &tape7_word_format;
+	  word_context->input_format = &tape7_word_format;
 	  break;
 	case 'W':
 	  if (parse_output_word_format (optarg))
@@ -538,6 +544,7 @@ main (int argc, char **argv)
 
   if (f == NULL)
     f = stdin;
+  map_word_input (f);
 
   list = info = stdout;
   if (verbose == 0)
@@ -545,6 +552,7 @@ main (int argc, char **argv)
   else if (verbose == 1)
     info = fopen ("/dev/null", "w");
 
+  atexit (report);
   for (;;)
     process_saveset (f);
 
@@ -16,20 +16,48 @@
 /* The unscr program takes a single argument, which is a file name.
    It will proceed to unscramble the contents with all possible
    passwords.  If the result is printable ASCII text, it's printed to
-   stdout. */
+   stdout.
+
+   The key space is split into chunks which are handed out to a
+   number of threads, set with -j.  With -c, progress is saved to a
+   checkpoint file after each chunk, and a search is resumed from
+   there if the file exists.
+
+   Keys are tried in batches, where the first word is unscrambled for
+   all keys in a batch at once.  Almost all keys are rejected by that
+   first word; the rest are unscrambled one word at a time until the
+   first bad character. */
 
 #include <time.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
+#include <pthread.h>
 
 #include "dis.h"
 
+/* Keys per chunk of work.  A dot is printed for each chunk. */
+#define CHUNK_KEYS (0100000000LL)
+#define CHUNKS ((0777777777777LL + 1) / CHUNK_KEYS)
+
+/* Keys per batch. */
+#define LANES 16
+
 /* Just allocate a few words to hold the start of the file. */
 static word_t buffer[100];
+static int n;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static const char *checkpoint = NULL;
+static word_t next_chunk;
+static word_t done_chunks;
+static char done[CHUNKS];
+static struct timespec start;
+static word_t searched_chunks;
 
 static void usage (const char *x)
 {
-  fprintf (stderr, "Usage: %s <file>\n", x);
+  fprintf (stderr, "Usage: %s [-j threads] [-c checkpoint] <file>\n", x);
   exit (1);
 }
 
@@ -67,60 +95,191 @@ bad (int ch)
 }
 
 static int
-accepted (word_t *output, int n)
+accepted (word_t word)
 {
+  if (word & 1)
+    return 0;
+  if (bad ((word >> 29) & 0177))
+    return 0;
+  if (bad ((word >> 22) & 0177))
+    return 0;
+  if (bad ((word >> 15) & 0177))
+    return 0;
+  if (bad ((word >>  8) & 0177))
+    return 0;
+  if (bad ((word >>  1) & 0177))
+    return 0;
+  return 1;
+}
+
+/* Continue unscrambling the rest of the words with a key which
+   passed the first word. */
+static void
+decrypt (word_t key, struct scramble_key *k, word_t first)
+{
+  word_t output[100];
   int i;
-  for (i = 0; i < n; i++)
+
+  output[0] = first;
+  for (i = 1; i < n; i++)
     {
-      if (output[i] & 1)
-	return 0;
-      if (bad ((output[i] >> 29) & 0177))
-	return 0;
-      if (bad ((output[i] >> 22) & 0177))
-	return 0;
-      if (bad ((output[i] >> 15) & 0177))
-	return 0;
-      if (bad ((output[i] >>  8) & 0177))
-	return 0;
-      if (bad ((output[i] >>  1) & 0177))
-	return 0;
+      output[i] = scramble_word (k, 1, buffer[i]);
+      if (!accepted (output[i]))
+	return;
     }
-  return 1;
-} 
+
+  flockfile (stdout);
+  printf ("\nKEY: ");
+  type6 (key);
+  putchar ('\n');
+  for (i = 0; i < n; i++)
+    type7 (output[i]);
+  funlockfile (stdout);
+}
 
 static void
-decrypt (word_t key, int n)
+decrypt_batch (word_t key)
 {
-  static word_t output[100];
+  struct scramble_key k[LANES];
+  word_t output[LANES];
   int i;
 
-  scramble (1, 0, key, buffer, output, n);
+  for (i = 0; i < LANES; i++)
+    scramble_key (&k[i], 1, key + i);
+
+  unscramble_lanes (k, LANES, buffer[0], output);
+
+  for (i = 0; i < LANES; i++)
+    if (accepted (output[i]))
+      decrypt (key + i, &k[i], output[i]);
+}
+
+static void
+report (word_t chunks)
+{
+  struct timespec now;
+  double seconds;
+
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  seconds = (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+  if (seconds > 0)
+    fprintf (stderr, "%.0f keys/s\n", chunks * CHUNK_KEYS / seconds);
+}
+
+static word_t
+read_checkpoint (void)
+{
+  word_t key;
+  FILE *f;
+
+  f = fopen (checkpoint, "r");
+  if (f == NULL)
+    return 0;
+  if (fscanf (f, "%llo", &key) != 1)
+    {
+      fprintf (stderr, "Bad checkpoint file %s.\n", checkpoint);
+      exit (1);
+    }
+  fclose (f);
+
+  fprintf (stderr, "Resuming from key %012llo.\n", key);
+  return key / CHUNK_KEYS;
+}
+
+/* Save the first key not yet searched, such that all keys before
+   it have been searched. */
+static void
+write_checkpoint (void)
+{
+  char tmp[1000];
+  FILE *f;
 
-  if (accepted(output, n))
+  snprintf (tmp, sizeof tmp, "%s.tmp", checkpoint);
+  f = fopen (tmp, "w");
+  if (f == NULL)
     {
-      printf ("\nKEY: ");
-      type6 (key);
-      putchar ('\n');
-      for (i = 0; i < n; i++)
-	type7 (output[i]);
+      fprintf (stderr, "Error writing checkpoint file %s.\n", tmp);
+      exit (1);
+    }
+  fprintf (f, "%012llo\n", done_chunks * CHUNK_KEYS);
+  fclose (f);
+  rename (tmp, checkpoint);
+}
+
+static void *
+worker (void *arg)
+{
+  word_t chunk, key, end;
+
+  (void)arg;
+
+  for (;;)
+    {
+      pthread_mutex_lock (&lock);
+      chunk = next_chunk++;
+      pthread_mutex_unlock (&lock);
+      if (chunk >= CHUNKS)
+	return NULL;
+
+      putchar ('.');
+      fflush (stdout);
+
+      end = (chunk + 1) * CHUNK_KEYS;
+      for (key = chunk * CHUNK_KEYS; key < end; key += LANES)
+	decrypt_batch (key);
+
+      pthread_mutex_lock (&lock);
+      done[chunk] = 1;
+      report (++searched_chunks);
+      if (chunk == done_chunks)
+	{
+	  while (done_chunks < CHUNKS && done[done_chunks])
+	    done_chunks++;
+	  if (checkpoint != NULL)
+	    write_checkpoint ();
+	}
+      pthread_mutex_unlock (&lock);
     }
 }
 
 int
 main (int argc, char **argv)
 {
+  pthread_t *threads;
+  int threads_n = 1;
   word_t word;
   word_t *p;
-  word_t key = 0;
   FILE *f;
-  int i, n;
+  int i, opt;
 
-  input_word_format = &its_word_format;
+  word_context->input_format = &its_word_format;
 
-  if (argc != 2)
+  while ((opt = getopt (argc, argv, "j:c:")) != -1)
+    {
+      switch (opt)
+	{
+	case 'j':
+	  threads_n = atoi (optarg);
+	  if (threads_n < 1)
+	    usage (argv[0]);
+	  break;
+	case 'c':
+	  checkpoint = optarg;
+	  break;
+	default:
+	  usage (argv[0]);
+	}
+    }
+
+  if (optind != argc - 1)
     usage (argv[0]);
 
-  f = fopen (argv[1], "rb");
+  f = fopen (argv[optind], "rb");
+  if (f == NULL)
+    {
+      fprintf (stderr, "Error opening %s.\n", argv[optind]);
+      exit (1);
+    }
 
   /* Only unscramble this many words. */
   n = 30;
@@ -132,16 +291,37 @@ main (int argc, char **argv)
       *p++ = word;
     }
   fclose (f);
+  n = i;
+
+  if (checkpoint != NULL)
+    next_chunk = done_chunks = read_checkpoint ();
 
-  for (key = 0; key <= 0777777777777LL; key++)
+  if (n == 0)
     {
-      if ((key & 077777777) == 0)
+      fprintf (stderr, "Empty file %s.\n", argv[optind]);
+      exit (1);
+    }
+
+  clock_gettime (CLOCK_MONOTONIC, &start);
+
+  threads = malloc (threads_n * sizeof *threads);
+  if (threads == NULL)
+    {
+      fprintf (stderr, "Out of memory.\n");
+      exit (1);
+    }
+
+  for (i = 0; i < threads_n; i++)
+    {
+      if (pthread_create (&threads[i], NULL, worker, NULL) != 0)
 	{
-	  putchar ('.');
-	  fflush (stdout);
+	  fprintf (stderr, "Error creating thread.\n");
+	  exit (1);
 	}
-      decrypt (key, n);
     }
 
+  for (i = 0; i < threads_n; i++)
+    pthread_join (threads[i], NULL);
+
   return 0;
 }